@@ -0,0 +1,103 @@
+#ifndef RK_BINARY_INDEXED_TREE_2D_HPP
+#define RK_BINARY_INDEXED_TREE_2D_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <rklib/utility/coordinate_compression.hpp>
+#include <vector>
+
+namespace rklib {
+
+// Point add / rectangle sum on points registered in advance.
+// Register every point with add_point, call build, then add / sum.
+// The y lists of all x-nodes are stored back to back in one array.
+template <class T, class W>
+struct OfflineBinaryIndexedTree2D {
+   public:
+    OfflineBinaryIndexedTree2D() {}
+
+    void add_point(T x, T y) { pts.emplace_back(x, y); }
+
+    void build() {
+        std::vector<T> xv(pts.size());
+        for (size_t i = 0; i < pts.size(); i++) xv[i] = pts[i].first;
+        xc = CoordComp<T>(std::move(xv));
+        int m = xc.size();
+
+        std::sort(pts.begin(), pts.end(),
+                  [](const std::pair<T, T> &a, const std::pair<T, T> &b) {
+                      return a.second < b.second;
+                  });
+        std::vector<std::vector<T>> tmp(m + 1);
+        for (auto &[x, y] : pts) {
+            for (int i = xc.get_idx(x) + 1; i <= m; i += i & -i) {
+                if (tmp[i].empty() || tmp[i].back() != y) tmp[i].push_back(y);
+            }
+        }
+        start.assign(m + 2, 0);
+        for (int i = 1; i <= m; i++) start[i + 1] = start[i] + tmp[i].size();
+        ys.resize(start[m + 1]);
+        for (int i = 1; i <= m; i++)
+            std::copy(tmp[i].begin(), tmp[i].end(), ys.begin() + start[i]);
+        dat.assign(ys.size(), W(0));
+        pts.clear();
+        pts.shrink_to_fit();
+    }
+
+    // (x, y) must have been registered
+    void add(T x, T y, W w) {
+        int m = xc.size();
+        int i = xc.get_idx(x);
+        assert(i < m && xc[i] == x);
+        for (++i; i <= m; i += i & -i) {
+            auto b = ys.begin() + start[i], e = ys.begin() + start[i + 1];
+            int k = std::lower_bound(b, e, y) - b;
+            assert(b + k != e && b[k] == y);
+            W *d = dat.data() + start[i];
+            int len = start[i + 1] - start[i];
+            for (++k; k <= len; k += k & -k) d[k - 1] += w;
+        }
+    }
+
+    // sum of weights in [xl, xr) x [yl, yr)
+    W sum(T xl, T xr, T yl, T yr) {
+        if (!(xl < xr) || !(yl < yr)) return W(0);
+        return sum_lower(xr, yl, yr) - sum_lower(xl, yl, yr);
+    }
+
+    // rects[i] = {xl, xr, yl, yr}
+    std::vector<W> sum(const std::vector<std::array<T, 4>> &rects) {
+        std::vector<W> res(rects.size());
+        for (size_t i = 0; i < rects.size(); i++) {
+            auto &[xl, xr, yl, yr] = rects[i];
+            res[i] = sum(xl, xr, yl, yr);
+        }
+        return res;
+    }
+
+   private:
+    std::vector<std::pair<T, T>> pts;
+    CoordComp<T> xc;
+    std::vector<int> start;
+    std::vector<T> ys;
+    std::vector<W> dat;
+
+    // x < xr, yl <= y < yr
+    W sum_lower(T xr, T yl, T yr) {
+        W res(0);
+        for (int i = xc.get_idx(xr); i > 0; i -= i & -i) {
+            auto b = ys.begin() + start[i], e = ys.begin() + start[i + 1];
+            const W *d = dat.data() + start[i];
+            for (int k = std::lower_bound(b, e, yr) - b; k > 0; k -= k & -k)
+                res += d[k - 1];
+            for (int k = std::lower_bound(b, e, yl) - b; k > 0; k -= k & -k)
+                res -= d[k - 1];
+        }
+        return res;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_BINARY_INDEXED_TREE_2D_HPP
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef RK_BITVECTOR_HPP
 #define RK_BITVECTOR_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -10,15 +11,19 @@ template <class T = int>
 struct BitVector {
    public:
     BitVector() : BitVector(0) {}
-    BitVector(int n) : BitVector(std::vector<T>(n, 0), 0) {}
-    BitVector(const std::vector<T> &a, int d = 0) {
-        int num = (a.size() >> lg) + 1;
-        sum.resize(num + 1, 0);
-        bit.resize(num, 0);
+    BitVector(int n) : sum((n >> lg) + 2, 0), bit((n >> lg) + 1, 0) {}
+    BitVector(const std::vector<T> &a, int d = 0) : BitVector((int)a.size()) {
         for (int i = 0; i < (int)a.size(); i++) {
-            if (a[i] >> d & 1) bit[i >> lg] |= (uint64_t)1 << (i & (w - 1));
+            if (a[i] >> d & 1) set(i);
         }
-        for (int k = 0; k < num; k++) {
+        build();
+    }
+
+    // rank is valid only after build() following the last set
+    void set(int i) { bit[i >> lg] |= (uint64_t)1 << (i & (w - 1)); }
+
+    void build() {
+        for (int k = 0; k < (int)bit.size(); k++) {
             sum[k + 1] = sum[k] + __builtin_popcountll(bit[k]);
         }
     }
@@ -30,6 +35,12 @@ struct BitVector {
         return x == 1 ? res : i - res;
     }
 
+    int get(int i) { return bit[i >> lg] >> (i & (w - 1)) & 1; }
+
+    std::size_t memory_bytes() const {
+        return sum.size() * sizeof(int) + bit.size() * sizeof(uint64_t);
+    }
+
    private:
     static constexpr int lg = 6;
     static constexpr int w = 1 << lg;
@@ -0,0 +1,74 @@
+#ifndef RK_CONVEX_HULL_TRICK_HPP
+#define RK_CONVEX_HULL_TRICK_HPP
+
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <utility>
+
+namespace rklib {
+
+// Min of lines a * x + b, lines added in non-increasing order of a.
+// Hull maintenance compares intersections by cross multiplication in
+// Wide (__int128 by default), so no floating point is involved.
+template <class T = long long, class Wide = __int128>
+struct MonotoneCHT {
+   public:
+    MonotoneCHT() {}
+
+    bool empty() { return lines.empty(); }
+
+    void add_line(T a, T b) {
+        assert(lines.empty() || a <= lines.back().first);
+        if (!lines.empty() && lines.back().first == a) {
+            if (lines.back().second <= b) return;
+            lines.pop_back();
+        }
+        while (lines.size() >= 2 &&
+               bad(lines[lines.size() - 2], lines.back(), {a, b}))
+            lines.pop_back();
+        lines.emplace_back(a, b);
+    }
+
+    // arbitrary x, O(log n)
+    T get_min(T x) {
+        assert(!lines.empty());
+        int lo = 0, hi = lines.size() - 1;
+        while (lo < hi) {
+            int m = (lo + hi) >> 1;
+            if (eval(lines[m], x) <= eval(lines[m + 1], x))
+                hi = m;
+            else
+                lo = m + 1;
+        }
+        return eval(lines[lo], x);
+    }
+
+    // x must be non-decreasing over calls; amortized O(1)
+    T get_min_monotone(T x) {
+        assert(!lines.empty());
+        while (lines.size() >= 2 && eval(lines[0], x) >= eval(lines[1], x))
+            lines.pop_front();
+        return eval(lines[0], x);
+    }
+
+   private:
+    std::deque<std::pair<T, T>> lines;
+
+    static T eval(const std::pair<T, T> &f, T x) {
+        return f.first * x + f.second;
+    }
+
+    // whether g is never strictly below both f and h (slopes f > g > h)
+    static bool bad(const std::pair<T, T> &f, const std::pair<T, T> &g,
+                    const std::pair<T, T> &h) {
+        return (Wide(h.second) - Wide(f.second)) *
+                   (Wide(f.first) - Wide(g.first)) <=
+               (Wide(g.second) - Wide(f.second)) *
+                   (Wide(f.first) - Wide(h.first));
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_CONVEX_HULL_TRICK_HPP
\ No newline at end of file
@@ -1,17 +1,23 @@
 #ifndef RK_DISJOINT_SPARSE_TABLE_HPP
 #define RK_DISJOINT_SPARSE_TABLE_HPP
 
+#include <rklib/utility/algebra.hpp>
 #include <rklib/utility/utility.hpp>
 #include <vector>
 
 namespace rklib {
 
-template <class S, S (*op)(S, S), S (*e)()>
-struct DisjointSparseTable {
+// Monoid: see rklib/utility/algebra.hpp
+template <class Monoid>
+struct DisjointSparseTableOf {
+    using S = typename Monoid::S;
+
    public:
-    DisjointSparseTable() : DisjointSparseTable(1) {}
-    DisjointSparseTable(int n) : DisjointSparseTable(std::vector<S>(n, e())) {}
-    DisjointSparseTable(std::vector<S> &v) : w((int)v.size()) {
+    DisjointSparseTableOf() : DisjointSparseTableOf(1) {}
+    DisjointSparseTableOf(int n, Monoid monoid = Monoid())
+        : DisjointSparseTableOf(std::vector<S>(n, monoid.e()), monoid) {}
+    DisjointSparseTableOf(const std::vector<S> &v, Monoid monoid = Monoid())
+        : monoid(monoid), w((int)v.size()) {
         if (w == 0) {
             h = 0;
             return;
@@ -51,10 +57,17 @@ struct DisjointSparseTable {
     }
 
    private:
+    Monoid monoid;
     int h, w;
     std::vector<std::vector<S>> table;
+
+    S op(S a, S b) { return monoid.op(a, b); }
+    S e() { return monoid.e(); }
 };
 
+template <class S, S (*op)(S, S), S (*e)()>
+using DisjointSparseTable = DisjointSparseTableOf<FunctionMonoid<S, op, e>>;
+
 }  // namespace rklib
 
 #endif  // RK_DISJOINT_SPARSE_TABLE_HPP
\ No newline at end of file
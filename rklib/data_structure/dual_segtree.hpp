@@ -2,16 +2,22 @@
 #define RK_DUAL_SEGTREE_HPP
 
 #include <cassert>
+#include <rklib/utility/algebra.hpp>
 #include <vector>
 
 namespace rklib {
 
-template <class S, S (*op)(S, S), S (*e)()>
-struct DualSegTree {
+// Monoid: see rklib/utility/algebra.hpp
+template <class Monoid>
+struct DualSegTreeOf {
+    using S = typename Monoid::S;
+
    public:
-    DualSegTree() : DualSegTree(0) {}
-    DualSegTree(int n) : DualSegTree(std::vector<S>(n, e())) {}
-    DualSegTree(const std::vector<S> &v) : _n(int(v.size())) {
+    DualSegTreeOf() : DualSegTreeOf(0) {}
+    DualSegTreeOf(int n, Monoid monoid = Monoid())
+        : DualSegTreeOf(std::vector<S>(n, monoid.e()), monoid) {}
+    DualSegTreeOf(const std::vector<S> &v, Monoid monoid = Monoid())
+        : monoid(monoid), _n(int(v.size())) {
         size = 1;
         log = 0;
         while (size < _n) size <<= 1, ++log;
@@ -43,10 +49,17 @@ struct DualSegTree {
     void all_prod(S x) { d[1] = op(d[1], x); }
 
    private:
+    Monoid monoid;
     int _n, size, log;
     std::vector<S> d;
+
+    S op(S a, S b) { return monoid.op(a, b); }
+    S e() { return monoid.e(); }
 };
 
+template <class S, S (*op)(S, S), S (*e)()>
+using DualSegTree = DualSegTreeOf<FunctionMonoid<S, op, e>>;
+
 }  // namespace rklib
 
 #endif  // RK_DUAL_SEGTREE_HPP
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef RK_FAST_SET_HPP
+#define RK_FAST_SET_HPP
+
+#include <cassert>
+#include <vector>
+
+namespace rklib {
+
+// Set of integers in [0, n) on layered 64-bit words.
+// insert / erase / next / prev work in O(log_64 n).
+// If with_rank is true, a Fenwick tree over the bottom words also gives
+// rank / kth in O(log n).
+template <bool with_rank = false>
+struct FastSet {
+    using lint = long long;
+    using ulint = unsigned long long;
+
+   public:
+    FastSet() : FastSet(0) {}
+    FastSet(lint n) : n(n), cnt(0) {
+        lint m = n;
+        do {
+            m = (m + w - 1) >> lg;
+            seg.push_back(std::vector<ulint>(m, 0ULL));
+        } while (m > 1);
+        if constexpr (with_rank) fen.resize(seg[0].size() + 1, 0);
+    }
+
+    lint size() { return cnt; }
+
+    bool contains(lint i) {
+        assert(0 <= i && i < n);
+        return seg[0][i >> lg] >> (i & mod_w) & 1;
+    }
+
+    void insert(lint i) {
+        if (contains(i)) return;
+        ++cnt;
+        if constexpr (with_rank) fen_add(i >> lg, 1);
+        for (auto &s : seg) {
+            s[i >> lg] |= 1ULL << (i & mod_w);
+            i >>= lg;
+        }
+    }
+
+    void erase(lint i) {
+        if (!contains(i)) return;
+        --cnt;
+        if constexpr (with_rank) fen_add(i >> lg, -1);
+        for (auto &s : seg) {
+            s[i >> lg] &= ~(1ULL << (i & mod_w));
+            if (s[i >> lg]) break;
+            i >>= lg;
+        }
+    }
+
+    // min element >= i (n if none)
+    lint next(lint i) {
+        if (i < 0) i = 0;
+        if (i >= n) return n;
+        for (int h = 0; h < (int)seg.size(); h++) {
+            if ((i >> lg) == (lint)seg[h].size()) break;
+            ulint d = seg[h][i >> lg] >> (i & mod_w);
+            if (d == 0) {
+                i = (i >> lg) + 1;
+                continue;
+            }
+            i += __builtin_ctzll(d);
+            for (int g = h - 1; g >= 0; g--) {
+                i <<= lg;
+                i += __builtin_ctzll(seg[g][i >> lg]);
+            }
+            return i;
+        }
+        return n;
+    }
+
+    // max element <= i (-1 if none)
+    lint prev(lint i) {
+        if (i >= n) i = n - 1;
+        for (int h = 0; h < (int)seg.size(); h++) {
+            if (i < 0) break;
+            ulint d = seg[h][i >> lg] << (mod_w - (i & mod_w));
+            if (d == 0) {
+                i = (i >> lg) - 1;
+                continue;
+            }
+            i -= __builtin_clzll(d);
+            for (int g = h - 1; g >= 0; g--) {
+                i <<= lg;
+                i += mod_w - __builtin_clzll(seg[g][i >> lg]);
+            }
+            return i;
+        }
+        return -1;
+    }
+
+    // number of elements < i
+    lint rank(lint i) {
+        static_assert(with_rank, "FastSet::rank requires with_rank = true");
+        if (i <= 0) return 0;
+        if (i >= n) return cnt;
+        lint res = 0;
+        for (lint k = i >> lg; k > 0; k -= k & -k) res += fen[k];
+        if (i & mod_w) {
+            res += __builtin_popcountll(seg[0][i >> lg] &
+                                        (~0ULL >> (w - (i & mod_w))));
+        }
+        return res;
+    }
+
+    // k-th smallest element, 0-indexed (n if none)
+    lint kth(lint k) {
+        static_assert(with_rank, "FastSet::kth requires with_rank = true");
+        if (k < 0 || k >= cnt) return n;
+        lint p = 0, m = fen.size() - 1;
+        for (lint b = lint(1) << (63 - __builtin_clzll(m)); b > 0; b >>= 1) {
+            if (p + b <= m && fen[p + b] <= k) {
+                p += b;
+                k -= fen[p];
+            }
+        }
+        ulint d = seg[0][p];
+        for (; k > 0; k--) d &= d - 1;
+        return (p << lg) + __builtin_ctzll(d);
+    }
+
+   private:
+    static constexpr int lg = 6, w = 64, mod_w = w - 1;
+    lint n, cnt;
+    std::vector<std::vector<ulint>> seg;
+    std::vector<lint> fen;
+
+    void fen_add(lint k, lint x) {
+        for (++k; k < (lint)fen.size(); k += k & -k) fen[k] += x;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_FAST_SET_HPP
\ No newline at end of file
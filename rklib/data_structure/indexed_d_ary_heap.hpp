@@ -0,0 +1,89 @@
+#ifndef RK_INDEXED_D_ARY_HEAP_HPP
+#define RK_INDEXED_D_ARY_HEAP_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Min-heap over vertices [0, n) with one key per vertex.
+// push(key, v) inserts v, or decreases its key if v is already queued,
+// so the heap never holds more than n entries.
+template <class T, int d = 4>
+struct IndexedDAryHeap {
+   public:
+    IndexedDAryHeap() : IndexedDAryHeap(0) {}
+    IndexedDAryHeap(int n) : pos(n, -1), key(n) {}
+
+    bool empty() { return heap.empty(); }
+
+    int size() { return heap.size(); }
+
+    bool contains(int v) { return pos[v] >= 0; }
+
+    void push(T k, int v) {
+        assert(0 <= v && v < (int)pos.size());
+        if (pos[v] < 0) {
+            pos[v] = heap.size();
+            heap.push_back(v);
+        } else if (!(k < key[v])) {
+            return;
+        }
+        key[v] = k;
+        sift_up(pos[v]);
+    }
+
+    std::pair<T, int> pop() {
+        assert(!heap.empty());
+        int v = heap[0];
+        pos[v] = -1;
+        int u = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = u;
+            pos[u] = 0;
+            sift_down(0);
+        }
+        return {key[v], v};
+    }
+
+   private:
+    std::vector<int> heap, pos;
+    std::vector<T> key;
+
+    void sift_up(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int p = (i - 1) / d;
+            if (!(key[v] < key[heap[p]])) break;
+            heap[i] = heap[p];
+            pos[heap[i]] = i;
+            i = p;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void sift_down(int i) {
+        int v = heap[i], n = heap.size();
+        while (true) {
+            int c = i * d + 1;
+            if (c >= n) break;
+            int e = std::min(c + d, n), m = c;
+            for (int j = c + 1; j < e; j++)
+                if (key[heap[j]] < key[heap[m]]) m = j;
+            if (!(key[heap[m]] < key[v])) break;
+            heap[i] = heap[m];
+            pos[heap[i]] = i;
+            i = m;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_INDEXED_D_ARY_HEAP_HPP
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef RK_LI_CHAO_TREE_HPP
+#define RK_LI_CHAO_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+namespace li_chao_internal {
+
+template <class T>
+struct Line {
+    T a, b;
+
+    T operator()(T x) const { return a * x + b; }
+};
+
+}  // namespace li_chao_internal
+
+// Min of lines a * x + b at query points known in advance.
+// All comparisons are exact evaluations at the query points.
+template <class T = long long>
+struct LiChaoTree {
+    using Line = li_chao_internal::Line<T>;
+
+   public:
+    LiChaoTree() : LiChaoTree(std::vector<T>()) {}
+    LiChaoTree(const std::vector<T> &x) : xs(x) {
+        std::sort(xs.begin(), xs.end());
+        xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+        _n = xs.size();
+        size = 1;
+        while (size < _n) size <<= 1;
+        if (_n > 0) xs.resize(size, xs.back());
+        d.assign(2 * size, Line{0, INF});
+    }
+
+    void add_line(T a, T b) {
+        if (_n > 0) insert(1, 0, size, Line{a, b});
+    }
+
+    // the line is present only for l <= x < r
+    void add_segment(T a, T b, T l, T r) {
+        int li = std::lower_bound(xs.begin(), xs.begin() + _n, l) - xs.begin();
+        int ri = std::lower_bound(xs.begin(), xs.begin() + _n, r) - xs.begin();
+        Line f{a, b};
+        li += size;
+        ri += size;
+        for (int len = 1; li < ri; li >>= 1, ri >>= 1, len <<= 1) {
+            if (li & 1) {
+                insert(li, li * len - size, (li + 1) * len - size, f);
+                ++li;
+            }
+            if (ri & 1) {
+                --ri;
+                insert(ri, ri * len - size, (ri + 1) * len - size, f);
+            }
+        }
+    }
+
+    // x must be one of the query points; INF if no line covers x
+    T get_min(T x) {
+        int i = std::lower_bound(xs.begin(), xs.begin() + _n, x) - xs.begin();
+        assert(i < _n && xs[i] == x);
+        T res = INF;
+        for (i += size; i > 0; i >>= 1) res = std::min(res, d[i](x));
+        return res;
+    }
+
+   private:
+    static constexpr T INF = std::numeric_limits<T>::max();
+    int _n, size;
+    std::vector<T> xs;
+    std::vector<Line> d;
+
+    void insert(int k, int l, int r, Line f) {
+        while (true) {
+            int m = (l + r) >> 1;
+            bool lef = f(xs[l]) < d[k](xs[l]);
+            bool mid = f(xs[m]) < d[k](xs[m]);
+            bool rig = f(xs[r - 1]) < d[k](xs[r - 1]);
+            if (lef && rig) {
+                d[k] = f;
+                return;
+            }
+            if (!lef && !rig) return;
+            if (mid) std::swap(d[k], f);
+            if (r - l == 1) return;
+            if (lef != mid) {
+                k = 2 * k;
+                r = m;
+            } else {
+                k = 2 * k + 1;
+                l = m;
+            }
+        }
+    }
+};
+
+// Min of lines a * x + b for integer x in [lo, hi).
+// Nodes are created on demand in one pool.
+template <class T = long long>
+struct DynamicLiChaoTree {
+    using Line = li_chao_internal::Line<T>;
+
+   public:
+    DynamicLiChaoTree(T lo, T hi) : lo(lo), hi(hi) {
+        assert(lo < hi);
+        nodes.push_back({Line{0, INF}, -1, -1});
+    }
+
+    void add_line(T a, T b) { insert(0, lo, hi, Line{a, b}); }
+
+    // the line is present only for l <= x < r
+    void add_segment(T a, T b, T l, T r) {
+        if (l < lo) l = lo;
+        if (r > hi) r = hi;
+        if (l < r) add_segment(0, lo, hi, l, r, Line{a, b});
+    }
+
+    // INF if no line covers x
+    T get_min(T x) {
+        assert(lo <= x && x < hi);
+        T res = INF, l = lo, r = hi;
+        for (int k = 0; k >= 0;) {
+            res = std::min(res, nodes[k].f(x));
+            T m = l + (r - l) / 2;
+            if (x < m) {
+                k = nodes[k].l;
+                r = m;
+            } else {
+                k = nodes[k].r;
+                l = m;
+            }
+        }
+        return res;
+    }
+
+   private:
+    struct Node {
+        Line f;
+        int l, r;
+    };
+
+    static constexpr T INF = std::numeric_limits<T>::max();
+    T lo, hi;
+    std::vector<Node> nodes;
+
+    int child(int k, bool right) {
+        int c = right ? nodes[k].r : nodes[k].l;
+        if (c >= 0) return c;
+        c = nodes.size();
+        nodes.push_back({Line{0, INF}, -1, -1});
+        (right ? nodes[k].r : nodes[k].l) = c;
+        return c;
+    }
+
+    void insert(int k, T l, T r, Line f) {
+        while (true) {
+            T m = l + (r - l) / 2;
+            bool lef = f(l) < nodes[k].f(l);
+            bool mid = f(m) < nodes[k].f(m);
+            bool rig = f(r - 1) < nodes[k].f(r - 1);
+            if (lef && rig) {
+                nodes[k].f = f;
+                return;
+            }
+            if (!lef && !rig) return;
+            if (mid) std::swap(nodes[k].f, f);
+            if (r - l == 1) return;
+            if (lef != mid) {
+                k = child(k, false);
+                r = m;
+            } else {
+                k = child(k, true);
+                l = m;
+            }
+        }
+    }
+
+    void add_segment(int k, T l, T r, T a, T b, Line f) {
+        if (b <= l || r <= a) return;
+        if (a <= l && r <= b) {
+            insert(k, l, r, f);
+            return;
+        }
+        T m = l + (r - l) / 2;
+        add_segment(child(k, false), l, m, a, b, f);
+        add_segment(child(k, true), m, r, a, b, f);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_LI_CHAO_TREE_HPP
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef RK_PATRICIA_TRIE_SET_HPP
+#define RK_PATRICIA_TRIE_SET_HPP
+
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Path-compressed BinaryTrieSet.
+// Each node keeps a representative key and the depth `dep` at which its
+// common prefix ends, so a key costs O(number of branching nodes) hops
+// instead of `len`.
+template <typename T, int len = 31>
+struct PatriciaTrieSet {
+   public:
+    PatriciaTrieSet() : root(-1) {}
+
+    int size() { return count_child(root); }
+
+    void insert(T val) { root = _insert(root, val); }
+
+    void erase(T val) { root = _erase(root, val); }
+
+    int count(T x) {
+        int t = root;
+        while (t >= 0) {
+            if (!match(t, x)) return 0;
+            if (nodes[t].dep == 0) return 1;
+            push(t);
+            t = nodes[t].ch[x >> (nodes[t].dep - 1) & 1];
+        }
+        return 0;
+    }
+
+    T get_kth(int k) {
+        int t = root;
+        while (nodes[t].dep > 0) {
+            push(t);
+            int l = nodes[t].ch[0];
+            if (nodes[l].cnt > k) {
+                t = l;
+            } else {
+                k -= nodes[l].cnt;
+                t = nodes[t].ch[1];
+            }
+        }
+        return nodes[t].key;
+    }
+
+    void apply_xor(T x) {
+        if (root >= 0) all_apply(root, x);
+    }
+
+   private:
+    struct Node {
+        int ch[2];
+        int cnt, dep;
+        T key, lz_xor;
+    };
+
+    int root;
+    std::vector<Node> nodes;
+    std::vector<int> free_list;
+
+    int new_node(T key, int dep, int cnt) {
+        int t;
+        if (free_list.empty()) {
+            t = nodes.size();
+            nodes.emplace_back();
+        } else {
+            t = free_list.back();
+            free_list.pop_back();
+        }
+        nodes[t] = {{-1, -1}, cnt, dep, key, 0};
+        return t;
+    }
+
+    void delete_node(int t) { free_list.push_back(t); }
+
+    int count_child(int t) { return t >= 0 ? nodes[t].cnt : 0; }
+
+    // whether x shares the prefix of node t
+    bool match(int t, T x) {
+        int d = nodes[t].dep;
+        return d >= len || ((x ^ nodes[t].key) >> d) == 0;
+    }
+
+    int update(int t) {
+        nodes[t].cnt =
+            count_child(nodes[t].ch[0]) + count_child(nodes[t].ch[1]);
+        return t;
+    }
+
+    void all_apply(int t, T x) {
+        nodes[t].key ^= x;
+        nodes[t].lz_xor ^= x;
+    }
+
+    void push(int t) {
+        T x = nodes[t].lz_xor;
+        if (x == 0) return;
+        if (x >> (nodes[t].dep - 1) & 1)
+            std::swap(nodes[t].ch[0], nodes[t].ch[1]);
+        all_apply(nodes[t].ch[0], x);
+        all_apply(nodes[t].ch[1], x);
+        nodes[t].lz_xor = 0;
+    }
+
+    int _insert(int t, T val) {
+        if (t < 0) return new_node(val, 0, 1);
+        if (!match(t, val)) {
+            unsigned long long diff = val ^ nodes[t].key;
+            int h = 63 - __builtin_clzll(diff);
+            int leaf = new_node(val, 0, 1);
+            int s = new_node(val, h + 1, nodes[t].cnt + 1);
+            int b = val >> h & 1;
+            nodes[s].ch[b] = leaf;
+            nodes[s].ch[b ^ 1] = t;
+            return s;
+        }
+        if (nodes[t].dep == 0) return t;
+        push(t);
+        int b = val >> (nodes[t].dep - 1) & 1;
+        int c = _insert(nodes[t].ch[b], val);
+        nodes[t].ch[b] = c;
+        return update(t);
+    }
+
+    int _erase(int t, T val) {
+        if (t < 0 || !match(t, val)) return t;
+        if (nodes[t].dep == 0) {
+            delete_node(t);
+            return -1;
+        }
+        push(t);
+        int b = val >> (nodes[t].dep - 1) & 1;
+        int c = _erase(nodes[t].ch[b], val);
+        if (c < 0) {
+            int other = nodes[t].ch[b ^ 1];
+            delete_node(t);
+            return other;
+        }
+        nodes[t].ch[b] = c;
+        return update(t);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_PATRICIA_TRIE_SET_HPP
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef RK_PERSISTENT_SEGTREE_HPP
+#define RK_PERSISTENT_SEGTREE_HPP
+
+#include <cassert>
+#include <vector>
+
+namespace rklib {
+
+template <class S, S (*op)(S, S), S (*e)()>
+struct PersistentSegTree {
+   public:
+    PersistentSegTree() : PersistentSegTree(0) {}
+    PersistentSegTree(int n) : PersistentSegTree(std::vector<S>(n, e())) {}
+    PersistentSegTree(const std::vector<S> &v) : _n(int(v.size())) {
+        size = 1;
+        log = 0;
+        while (size < _n) size <<= 1, ++log;
+        nodes.reserve(2 * size);
+        roots.push_back(build(0, size, v));
+    }
+
+    // reserve the pool for q more updates
+    void reserve(int q) { nodes.reserve(nodes.size() + (q * (log + 1))); }
+
+    int versions() { return roots.size(); }
+
+    // new version = version `ver` with a[p] <- x; returns its id
+    int set(int ver, int p, S x) {
+        assert(0 <= ver && ver < versions());
+        assert(0 <= p && p < _n);
+        roots.push_back(_set(roots[ver], 0, size, p, x));
+        return roots.size() - 1;
+    }
+
+    S get(int ver, int p) {
+        assert(0 <= ver && ver < versions());
+        assert(0 <= p && p < _n);
+        int t = roots[ver];
+        for (int a = 0, b = size; b - a > 1;) {
+            int m = (a + b) >> 1;
+            if (p < m)
+                t = nodes[t].l, b = m;
+            else
+                t = nodes[t].r, a = m;
+        }
+        return nodes[t].val;
+    }
+
+    S prod(int ver, int l, int r) {
+        assert(0 <= ver && ver < versions());
+        assert(0 <= l && l <= r && r <= _n);
+        return _prod(roots[ver], 0, size, l, r);
+    }
+
+    S all_prod(int ver) {
+        assert(0 <= ver && ver < versions());
+        return nodes[roots[ver]].val;
+    }
+
+    template <class G>
+    int max_right(int ver, int l, G g) {
+        assert(0 <= ver && ver < versions());
+        return max_right(ver, ver, l, [&](S x, S) { return g(x); });
+    }
+
+    // Descent on two versions at once: the largest r such that
+    // g(prod(ver_r, l, r), prod(ver_l, l, r)) holds, g monotone in r.
+    // e.g. g(x, y) = (x - y <= k) for the k-th smallest on value-indexed
+    // counts built over prefixes.
+    template <class G>
+    int max_right(int ver_l, int ver_r, int l, G g) {
+        assert(0 <= ver_l && ver_l < versions());
+        assert(0 <= ver_r && ver_r < versions());
+        assert(0 <= l && l <= _n);
+        assert(g(e(), e()));
+        if (l == _n) return _n;
+        S sr = e(), sl = e();
+        int res = _max_right(roots[ver_r], roots[ver_l], 0, size, l, g, sr, sl);
+        return res < _n ? res : _n;
+    }
+
+   private:
+    struct Node {
+        int l, r;
+        S val;
+    };
+
+    int _n, size, log;
+    std::vector<Node> nodes;
+    std::vector<int> roots;
+
+    int new_node(int l, int r, S val) {
+        nodes.push_back({l, r, val});
+        return nodes.size() - 1;
+    }
+
+    int build(int a, int b, const std::vector<S> &v) {
+        if (b - a == 1) return new_node(-1, -1, a < _n ? v[a] : e());
+        int m = (a + b) >> 1;
+        int l = build(a, m, v), r = build(m, b, v);
+        return new_node(l, r, op(nodes[l].val, nodes[r].val));
+    }
+
+    int _set(int t, int a, int b, int p, const S &x) {
+        if (b - a == 1) return new_node(-1, -1, x);
+        int m = (a + b) >> 1;
+        int l = nodes[t].l, r = nodes[t].r;
+        if (p < m)
+            l = _set(l, a, m, p, x);
+        else
+            r = _set(r, m, b, p, x);
+        return new_node(l, r, op(nodes[l].val, nodes[r].val));
+    }
+
+    S _prod(int t, int a, int b, int l, int r) {
+        if (r <= a || b <= l) return e();
+        if (l <= a && b <= r) return nodes[t].val;
+        int m = (a + b) >> 1;
+        return op(_prod(nodes[t].l, a, m, l, r), _prod(nodes[t].r, m, b, l, r));
+    }
+
+    // first position where g fails, or size if none
+    template <class G>
+    int _max_right(int tr, int tl, int a, int b, int l, G &g, S &sr, S &sl) {
+        if (b <= l) return size;
+        if (l <= a) {
+            S nr = op(sr, nodes[tr].val), nl = op(sl, nodes[tl].val);
+            if (g(nr, nl)) {
+                sr = nr;
+                sl = nl;
+                return size;
+            }
+            if (b - a == 1) return a;
+        }
+        int m = (a + b) >> 1;
+        int res = _max_right(nodes[tr].l, nodes[tl].l, a, m, l, g, sr, sl);
+        if (res != size) return res;
+        return _max_right(nodes[tr].r, nodes[tl].r, m, b, l, g, sr, sl);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_PERSISTENT_SEGTREE_HPP
\ No newline at end of file
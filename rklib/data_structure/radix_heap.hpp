@@ -0,0 +1,67 @@
+#ifndef RK_RADIX_HEAP_HPP
+#define RK_RADIX_HEAP_HPP
+
+#include <array>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Min-heap of (key, vertex) for monotone non-negative integer keys:
+// a pushed key must not be smaller than the last popped one.
+template <class T>
+struct RadixHeap {
+    using U = std::make_unsigned_t<T>;
+
+   public:
+    RadixHeap() : RadixHeap(0) {}
+    RadixHeap(int) : sz(0), last(0) {}
+
+    bool empty() { return sz == 0; }
+
+    int size() { return sz; }
+
+    void push(T key, int v) {
+        assert(U(key) >= last);
+        buckets[bucket(U(key) ^ last)].emplace_back(key, v);
+        ++sz;
+    }
+
+    std::pair<T, int> pop() {
+        assert(sz > 0);
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            last = U(buckets[i][0].first);
+            for (auto &p : buckets[i])
+                if (U(p.first) < last) last = U(p.first);
+            for (auto &p : buckets[i])
+                buckets[bucket(U(p.first) ^ last)].push_back(p);
+            buckets[i].clear();
+        }
+        --sz;
+        auto res = buckets[0].back();
+        buckets[0].pop_back();
+        return res;
+    }
+
+   private:
+    static constexpr int w = sizeof(U) * 8;
+    int sz;
+    U last;
+    std::array<std::vector<std::pair<T, int>>, w + 1> buckets;
+
+    static int bucket(U x) {
+        if (x == 0) return 0;
+        if constexpr (w > 32)
+            return 64 - __builtin_clzll(x);
+        else
+            return 32 - __builtin_clz(x);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_RADIX_HEAP_HPP
\ No newline at end of file
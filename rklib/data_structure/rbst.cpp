@@ -1,10 +1,20 @@
-template <class S, S (*op)(S, S), S (*e)(), class F, S (*mapping)(F, S),
-          F (*composition)(F, F), F (*id)()>
-struct RBST {
+#include <rklib/utility/algebra.hpp>
+
+// Act: see rklib/utility/algebra.hpp
+template <class Act>
+struct RBSTOf {
+    using S = typename Act::S;
+    using F = typename Act::F;
+
    public:
-    RBST() : RBST(0) {}
-    RBST(int n) : RBST(vector<S>(n, e())) {}
-    RBST(vector<S> &v) : root(nullptr) { root = build(0, v.size(), v); }
+    RBSTOf() : RBSTOf(0) {}
+    RBSTOf(int n, unsigned long long seed = 0, Act act = Act())
+        : RBSTOf(vector<S>(n, act.e()), seed, act) {}
+    RBSTOf(const vector<S> &v, unsigned long long seed = 0, Act act = Act())
+        : act(act), root(nullptr) {
+        set_seed(seed);
+        root = build(0, v.size(), v);
+    }
 
     struct Node {
         Node *l, *r;
@@ -13,19 +23,19 @@ struct RBST {
         F lazy;
         bool rev;
 
-        Node(S val = e())
+        Node(S val, F lazy)
             : l(nullptr),
               r(nullptr),
               cnt(1),
               val(val),
               sum(val),
-              lazy(id()),
+              lazy(lazy),
               rev(false) {}
     };
 
     void insert(int p, S x) {
         auto [l, r] = split(root, p);
-        auto m = new Node(x);
+        auto m = new Node(x, id());
         root = merge(merge(l, m), r);
     }
 
@@ -68,20 +78,40 @@ struct RBST {
     }
 
    private:
+    Act act;
     Node *root;
 
-    inline int gen() {
-        static int x = 123456789;
-        static int y = 362436069;
-        static int z = 521288629;
-        static int w = 88675123;
-        int t;
+    S op(S a, S b) { return act.op(a, b); }
+    S e() { return act.e(); }
+    S mapping(F f, S x) { return act.mapping(f, x); }
+    F composition(F f, F g) { return act.composition(f, g); }
+    F id() { return act.id(); }
+
+    // xorshift128, one state per instance. The state also mixes in the
+    // number of instances built before, so two instances with the same
+    // seed draw independent priorities, and a run that builds them in the
+    // same order stays replayable.
+    unsigned int rx, ry, rz, rw;
+
+    static unsigned int next_instance() {
+        static atomic<unsigned int> cnt{0};
+        return cnt++;
+    }
 
-        t = x ^ (x << 11);
-        x = y;
-        y = z;
-        z = w;
-        return w = (w ^ (w >> 19)) ^ (t ^ (t >> 8));
+    void set_seed(unsigned long long seed) {
+        rx = 123456789u ^ (unsigned int)seed;
+        ry = 362436069u ^ (unsigned int)(seed >> 32);
+        rz = 521288629u ^ (next_instance() * 2654435761u);
+        rw = 88675123u;
+        for (int i = 0; i < 16; i++) gen();
+    }
+
+    inline unsigned int gen() {
+        unsigned int t = rx ^ (rx << 11);
+        rx = ry;
+        ry = rz;
+        rz = rw;
+        return rw = (rw ^ (rw >> 19)) ^ (t ^ (t >> 8));
     }
 
     int count(Node *t) { return t ? t->cnt : 0; }
@@ -123,7 +153,7 @@ struct RBST {
 
     Node *merge(Node *l, Node *r) {
         if (!l || !r) return l ? l : r;
-        if (gen() % (count(l) + count(r)) < count(l)) {
+        if (gen() % (count(l) + count(r)) < (unsigned int)count(l)) {
             push(l);
             l->r = merge(l->r, r);
             return update(l);
@@ -148,12 +178,16 @@ struct RBST {
         }
     }
 
-    Node *build(int l, int r, vector<S> &v) {
+    Node *build(int l, int r, const vector<S> &v) {
         if (l == (int)v.size()) return nullptr;
         if (r - l == 1) {
-            auto t = new Node(v[l]);
+            auto t = new Node(v[l], id());
             return t;
         }
         return merge(build(l, (l + r) / 2, v), build((l + r) / 2, r, v));
     }
-};
\ No newline at end of file
+};
+
+template <class S, S (*op)(S, S), S (*e)(), class F, S (*mapping)(F, S),
+          F (*composition)(F, F), F (*id)()>
+using RBST = RBSTOf<rklib::FunctionAct<S, op, e, F, mapping, composition, id>>;
\ No newline at end of file
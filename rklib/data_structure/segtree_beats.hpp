@@ -0,0 +1,231 @@
+#ifndef RK_SEGTREE_BEATS_HPP
+#define RK_SEGTREE_BEATS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace rklib {
+
+// Range chmin / chmax / add, range sum / max / min.
+// chmin and chmax are amortized O(log^2 n), everything else O(log n).
+// All node fields are flat arrays; queries and add run bottom-up like
+// an iterative lazy segment tree, chmin / chmax recurse only where the
+// second maximum / minimum blocks the tag.
+template <class T = long long>
+struct SegTreeBeats {
+   public:
+    SegTreeBeats() : SegTreeBeats(0) {}
+    SegTreeBeats(int n) : SegTreeBeats(std::vector<T>(n, 0)) {}
+    SegTreeBeats(const std::vector<T> &v) : _n(int(v.size())) {
+        size = 1;
+        log = 0;
+        while (size < _n) size <<= 1, ++log;
+        max1.assign(2 * size, NINF);
+        max2.assign(2 * size, NINF);
+        min1.assign(2 * size, INF);
+        min2.assign(2 * size, INF);
+        maxc.assign(2 * size, 0);
+        minc.assign(2 * size, 0);
+        sum.assign(2 * size, 0);
+        lazy.assign(2 * size, 0);
+        len.assign(2 * size, 0);
+        for (int i = 0; i < _n; i++) {
+            max1[size + i] = min1[size + i] = sum[size + i] = v[i];
+            maxc[size + i] = minc[size + i] = len[size + i] = 1;
+        }
+        for (int i = size - 1; i >= 1; i--) {
+            len[i] = len[2 * i] + len[2 * i + 1];
+            update(i);
+        }
+    }
+
+    void chmin(int l, int r, T x) {
+        assert(0 <= l && l <= r && r <= _n);
+        _chmin(l, r, x, 1, 0, size);
+    }
+
+    void chmax(int l, int r, T x) {
+        assert(0 <= l && l <= r && r <= _n);
+        _chmax(l, r, x, 1, 0, size);
+    }
+
+    void add(int l, int r, T x) {
+        assert(0 <= l && l <= r && r <= _n);
+        if (l == r) return;
+        l += size;
+        r += size;
+        push_boundary(l, r);
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) all_add(a++, x);
+            if (b & 1) all_add(--b, x);
+        }
+        for (int i = 1; i <= log; i++) {
+            if (((l >> i) << i) != l) update(l >> i);
+            if (((r >> i) << i) != r) update((r - 1) >> i);
+        }
+    }
+
+    T get(int p) {
+        assert(0 <= p && p < _n);
+        p += size;
+        for (int i = log; i >= 1; i--) push(p >> i);
+        return sum[p];
+    }
+
+    T prod_sum(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        T res = 0;
+        l += size;
+        r += size;
+        push_boundary(l, r);
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) res += sum[l++];
+            if (r & 1) res += sum[--r];
+        }
+        return res;
+    }
+
+    T prod_max(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        T res = NINF;
+        l += size;
+        r += size;
+        push_boundary(l, r);
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) res = std::max(res, max1[l++]);
+            if (r & 1) res = std::max(res, max1[--r]);
+        }
+        return res;
+    }
+
+    T prod_min(int l, int r) {
+        assert(0 <= l && l <= r && r <= _n);
+        T res = INF;
+        l += size;
+        r += size;
+        push_boundary(l, r);
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) res = std::min(res, min1[l++]);
+            if (r & 1) res = std::min(res, min1[--r]);
+        }
+        return res;
+    }
+
+   private:
+    static constexpr T INF = std::numeric_limits<T>::max();
+    static constexpr T NINF = std::numeric_limits<T>::lowest();
+    int _n, size, log;
+    std::vector<T> max1, max2, min1, min2, sum, lazy;
+    std::vector<int> maxc, minc, len;
+
+    void update(int k) {
+        int a = 2 * k, b = 2 * k + 1;
+        sum[k] = sum[a] + sum[b];
+
+        if (max1[a] > max1[b]) {
+            max1[k] = max1[a];
+            maxc[k] = maxc[a];
+            max2[k] = std::max(max2[a], max1[b]);
+        } else if (max1[a] < max1[b]) {
+            max1[k] = max1[b];
+            maxc[k] = maxc[b];
+            max2[k] = std::max(max1[a], max2[b]);
+        } else {
+            max1[k] = max1[a];
+            maxc[k] = maxc[a] + maxc[b];
+            max2[k] = std::max(max2[a], max2[b]);
+        }
+
+        if (min1[a] < min1[b]) {
+            min1[k] = min1[a];
+            minc[k] = minc[a];
+            min2[k] = std::min(min2[a], min1[b]);
+        } else if (min1[a] > min1[b]) {
+            min1[k] = min1[b];
+            minc[k] = minc[b];
+            min2[k] = std::min(min1[a], min2[b]);
+        } else {
+            min1[k] = min1[a];
+            minc[k] = minc[a] + minc[b];
+            min2[k] = std::min(min2[a], min2[b]);
+        }
+    }
+
+    // lower the maximum of k to x, where max2[k] < x < max1[k]
+    void tag_max(int k, T x) {
+        sum[k] += (x - max1[k]) * maxc[k];
+        if (max1[k] == min1[k])
+            min1[k] = x;
+        else if (max1[k] == min2[k])
+            min2[k] = x;
+        max1[k] = x;
+    }
+
+    // raise the minimum of k to x, where min1[k] < x < min2[k]
+    void tag_min(int k, T x) {
+        sum[k] += (x - min1[k]) * minc[k];
+        if (min1[k] == max1[k])
+            max1[k] = x;
+        else if (min1[k] == max2[k])
+            max2[k] = x;
+        min1[k] = x;
+    }
+
+    void all_add(int k, T x) {
+        if (len[k] == 0) return;
+        max1[k] += x;
+        if (max2[k] != NINF) max2[k] += x;
+        min1[k] += x;
+        if (min2[k] != INF) min2[k] += x;
+        sum[k] += x * len[k];
+        lazy[k] += x;
+    }
+
+    void push(int k) {
+        for (int c = 2 * k; c <= 2 * k + 1; c++) {
+            if (lazy[k] != 0) all_add(c, lazy[k]);
+            if (max1[k] < max1[c]) tag_max(c, max1[k]);
+            if (min1[k] > min1[c]) tag_min(c, min1[k]);
+        }
+        lazy[k] = 0;
+    }
+
+    void push_boundary(int l, int r) {
+        for (int i = log; i >= 1; i--) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push((r - 1) >> i);
+        }
+    }
+
+    void _chmin(int l, int r, T x, int k, int a, int b) {
+        if (r <= a || b <= l || max1[k] <= x) return;
+        if (l <= a && b <= r && max2[k] < x) {
+            tag_max(k, x);
+            return;
+        }
+        push(k);
+        int m = (a + b) >> 1;
+        _chmin(l, r, x, 2 * k, a, m);
+        _chmin(l, r, x, 2 * k + 1, m, b);
+        update(k);
+    }
+
+    void _chmax(int l, int r, T x, int k, int a, int b) {
+        if (r <= a || b <= l || min1[k] >= x) return;
+        if (l <= a && b <= r && min2[k] > x) {
+            tag_min(k, x);
+            return;
+        }
+        push(k);
+        int m = (a + b) >> 1;
+        _chmax(l, r, x, 2 * k, a, m);
+        _chmax(l, r, x, 2 * k + 1, m, b);
+        update(k);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_SEGTREE_BEATS_HPP
\ No newline at end of file
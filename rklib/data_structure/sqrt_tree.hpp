@@ -0,0 +1,150 @@
+#ifndef RK_SQRT_TREE_HPP
+#define RK_SQRT_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace rklib {
+
+// Range product for any monoid in O(1), O(n log log n) memory.
+// Layer k splits every block of size 2^layers[k] into sqrt-sized blocks
+// and stores in-block prefix / suffix products and products between
+// blocks. set is O(sqrt n).
+template <class S, S (*op)(S, S), S (*e)()>
+struct SqrtTree {
+   public:
+    SqrtTree() : SqrtTree(0) {}
+    SqrtTree(int n) : SqrtTree(std::vector<S>(n, e())) {}
+    SqrtTree(const std::vector<S> &a) : n(a.size()), v(a) {
+        lg = 0;
+        while ((1 << lg) < n) ++lg;
+        on_layer.resize(lg + 1, 0);
+        for (int t = lg; t > 1; t = (t + 1) >> 1) {
+            on_layer[t] = layers.size();
+            layers.push_back(t);
+        }
+        for (int i = lg - 1; i >= 0; i--)
+            on_layer[i] = std::max(on_layer[i], on_layer[i + 1]);
+        int between_layers = std::max(0, int(layers.size()) - 1);
+        int bsz_log = (lg + 1) >> 1, bsz = 1 << bsz_log;
+        index_sz = (n + bsz - 1) >> bsz_log;
+        v.resize(n + index_sz);
+        pref.assign(layers.size(), std::vector<S>(n + index_sz, e()));
+        suf.assign(layers.size(), std::vector<S>(n + index_sz, e()));
+        between.assign(between_layers, std::vector<S>((1 << lg) + bsz, e()));
+        build(0, 0, n, 0);
+    }
+
+    S prod(int l, int r) {
+        assert(0 <= l && l <= r && r <= n);
+        if (l == r) return e();
+        return query(l, r - 1, 0, 0);
+    }
+
+    S get(int p) {
+        assert(0 <= p && p < n);
+        return v[p];
+    }
+
+    void set(int p, S x) {
+        assert(0 <= p && p < n);
+        v[p] = x;
+        update(0, 0, n, 0, p);
+    }
+
+   private:
+    int n, lg, index_sz;
+    std::vector<S> v;
+    std::vector<int> layers, on_layer;
+    std::vector<std::vector<S>> pref, suf, between;
+
+    void build_block(int layer, int l, int r) {
+        pref[layer][l] = v[l];
+        for (int i = l + 1; i < r; i++)
+            pref[layer][i] = op(pref[layer][i - 1], v[i]);
+        suf[layer][r - 1] = v[r - 1];
+        for (int i = r - 2; i >= l; i--)
+            suf[layer][i] = op(v[i], suf[layer][i + 1]);
+    }
+
+    void build_between(int layer, int lb, int rb, int offs) {
+        int bsz_log = (layers[layer] + 1) >> 1;
+        int bcnt_log = layers[layer] >> 1;
+        int bcnt = (rb - lb + (1 << bsz_log) - 1) >> bsz_log;
+        for (int i = 0; i < bcnt; i++) {
+            S ans = e();
+            for (int j = i; j < bcnt; j++) {
+                ans = op(ans, suf[layer][lb + (j << bsz_log)]);
+                between[layer - 1][offs + lb + (i << bcnt_log) + j] = ans;
+            }
+        }
+    }
+
+    // the block products of layer 0 are kept as a sqrt tree of their own
+    // in v[n, n + index_sz)
+    void build_between_zero() {
+        int bsz_log = (lg + 1) >> 1;
+        for (int i = 0; i < index_sz; i++) v[n + i] = suf[0][i << bsz_log];
+        build(1, n, n + index_sz, (1 << lg) - n);
+    }
+
+    void update_between_zero(int bid) {
+        int bsz_log = (lg + 1) >> 1;
+        v[n + bid] = suf[0][bid << bsz_log];
+        update(1, n, n + index_sz, (1 << lg) - n, n + bid);
+    }
+
+    void build(int layer, int lb, int rb, int offs) {
+        if (layer >= (int)layers.size()) return;
+        int bsz = 1 << ((layers[layer] + 1) >> 1);
+        for (int l = lb; l < rb; l += bsz) {
+            int r = std::min(l + bsz, rb);
+            build_block(layer, l, r);
+            build(layer + 1, l, r, offs);
+        }
+        if (layer == 0)
+            build_between_zero();
+        else
+            build_between(layer, lb, rb, offs);
+    }
+
+    void update(int layer, int lb, int rb, int offs, int x) {
+        if (layer >= (int)layers.size()) return;
+        int bsz_log = (layers[layer] + 1) >> 1;
+        int bid = (x - lb) >> bsz_log;
+        int l = lb + (bid << bsz_log);
+        int r = std::min(l + (1 << bsz_log), rb);
+        build_block(layer, l, r);
+        if (layer == 0)
+            update_between_zero(bid);
+        else
+            build_between(layer, lb, rb, offs);
+        update(layer + 1, l, r, offs, x);
+    }
+
+    // product of [l, r], both inclusive
+    S query(int l, int r, int offs, int base) {
+        if (l == r) return v[l];
+        if (l + 1 == r) return op(v[l], v[r]);
+        int layer = on_layer[32 - __builtin_clz((l - base) ^ (r - base))];
+        int bsz_log = (layers[layer] + 1) >> 1;
+        int bcnt_log = layers[layer] >> 1;
+        int lb = (((l - base) >> layers[layer]) << layers[layer]) + base;
+        int lblock = ((l - lb) >> bsz_log) + 1;
+        int rblock = ((r - lb) >> bsz_log) - 1;
+        S ans = suf[layer][l];
+        if (lblock <= rblock) {
+            S add = (layer == 0)
+                        ? query(n + lblock, n + rblock, (1 << lg) - n, n)
+                        : between[layer - 1]
+                                 [offs + lb + (lblock << bcnt_log) + rblock];
+            ans = op(ans, add);
+        }
+        return op(ans, pref[layer][r]);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_SQRT_TREE_HPP
\ No newline at end of file
@@ -1,38 +1,52 @@
 #ifndef RK_TREAP_HPP
 #define RK_TREAP_HPP
 
+#include <atomic>
+#include <rklib/utility/algebra.hpp>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace rklib {
 
-template <class S, S (*op)(S, S), S (*e)(), class F, S (*mapping)(F, S),
-          F (*composition)(F, F), F (*id)()>
-struct Treap {
+// Act: see rklib/utility/algebra.hpp
+template <class Act>
+struct TreapOf {
+    using S = typename Act::S;
+    using F = typename Act::F;
+
    public:
-    Treap() : Treap(0) {}
-    Treap(int n) : Treap(std::vector<S>(n, e())) {}
-    Treap(std::vector<S> &v) : root(nullptr) { root = build(0, v.size(), v); }
+    TreapOf() : TreapOf(0) {}
+    TreapOf(int n, unsigned long long seed = 0, Act act = Act())
+        : TreapOf(std::vector<S>(n, act.e()), seed, act) {}
+    TreapOf(const std::vector<S> &v, unsigned long long seed = 0,
+            Act act = Act())
+        : act(act), root(nullptr) {
+        set_seed(seed);
+        root = build(0, v.size(), v);
+    }
 
     struct Node {
         Node *l, *r;
-        int pri, cnt;
+        unsigned int pri;
+        int cnt;
         S val, sum;
         F lazy;
         bool rev;
 
-        Node(S val = e())
+        Node(S val, F lazy)
             : l(nullptr),
               r(nullptr),
               cnt(1),
               val(val),
               sum(val),
-              lazy(id()),
+              lazy(lazy),
               rev(false) {}
     };
 
     void insert(int p, S x) {
         auto [l, r] = split(root, p);
-        auto m = new Node(x);
+        auto m = new Node(x, id());
         m->pri = gen();
         root = merge(merge(l, m), r);
     }
@@ -75,21 +89,102 @@ struct Treap {
         root = merge(merge(merge(l_node, n_node), m_node), r_node);
     }
 
+    int size() { return count(root); }
+
+    // Ordered-set mode: the sequence is kept sorted by operator< on S.
+    // Use only these members (and prod / apply that keep the order).
+
+    void insert_key(S x) { insert(lower_bound(x), x); }
+
+    // erase one occurrence of x, if any
+    void erase_key(S x) {
+        auto [l, mr] = split_key(root, x, false);
+        auto [m, r] = split(mr, 1);
+        if (m && x < m->val) {
+            r = merge(m, r);
+            m = nullptr;
+        }
+        delete m;
+        root = merge(l, r);
+    }
+
+    // number of elements < x
+    int lower_bound(S x) { return bound(x, false); }
+
+    // number of elements <= x
+    int upper_bound(S x) { return bound(x, true); }
+
+    S kth(int k) {
+        auto t = root;
+        while (true) {
+            push(t);
+            if (k < count(t->l)) {
+                t = t->l;
+            } else if (k == count(t->l)) {
+                return t->val;
+            } else {
+                k -= count(t->l) + 1;
+                t = t->r;
+            }
+        }
+    }
+
+    // Set operations of two sorted treaps in O(m log(n/m + 1)).
+    // Nodes of `other` are consumed and it becomes empty.
+
+    // multiset sum
+    void set_union(TreapOf &other) {
+        root = unite(root, other.root);
+        other.root = nullptr;
+    }
+
+    // keep the elements whose key occurs in other
+    void set_intersection(TreapOf &other) {
+        root = intersect(root, other.root);
+        other.root = nullptr;
+    }
+
+    // keep the elements whose key does not occur in other
+    void set_difference(TreapOf &other) {
+        root = subtract(root, other.root);
+        other.root = nullptr;
+    }
+
    private:
+    Act act;
     Node *root;
 
-    inline int gen() {
-        static int x = 123456789;
-        static int y = 362436069;
-        static int z = 521288629;
-        static int w = 88675123;
-        int t;
+    S op(S a, S b) { return act.op(a, b); }
+    S e() { return act.e(); }
+    S mapping(F f, S x) { return act.mapping(f, x); }
+    F composition(F f, F g) { return act.composition(f, g); }
+    F id() { return act.id(); }
+
+    // xorshift128, one state per instance. The state also mixes in the
+    // number of instances built before, so two instances with the same
+    // seed draw independent priorities, and a run that builds them in the
+    // same order stays replayable.
+    unsigned int rx, ry, rz, rw;
 
-        t = x ^ (x << 11);
-        x = y;
-        y = z;
-        z = w;
-        return w = (w ^ (w >> 19)) ^ (t ^ (t >> 8));
+    static unsigned int next_instance() {
+        static std::atomic<unsigned int> cnt{0};
+        return cnt++;
+    }
+
+    void set_seed(unsigned long long seed) {
+        rx = 123456789u ^ (unsigned int)seed;
+        ry = 362436069u ^ (unsigned int)(seed >> 32);
+        rz = 521288629u ^ (next_instance() * 2654435761u);
+        rw = 88675123u;
+        for (int i = 0; i < 16; i++) gen();
+    }
+
+    inline unsigned int gen() {
+        unsigned int t = rx ^ (rx << 11);
+        rx = ry;
+        ry = rz;
+        rz = rw;
+        return rw = (rw ^ (rw >> 19)) ^ (t ^ (t >> 8));
     }
 
     int count(Node *t) { return t ? t->cnt : 0; }
@@ -156,10 +251,126 @@ struct Treap {
         }
     }
 
-    Node *build(int l, int r, std::vector<S> &v) {
+    // (elements < x, rest), or (elements <= x, rest) if inclusive
+    std::pair<Node *, Node *> split_key(Node *t, const S &x, bool inclusive) {
+        if (!t) return {t, t};
+        push(t);
+        if (inclusive ? x < t->val : !(t->val < x)) {
+            auto [l, r] = split_key(t->l, x, inclusive);
+            t->l = r;
+            return {l, update(t)};
+        } else {
+            auto [l, r] = split_key(t->r, x, inclusive);
+            t->r = l;
+            return {update(t), r};
+        }
+    }
+
+    // (elements < x, elements == x, elements > x)
+    std::tuple<Node *, Node *, Node *> split_key3(Node *t, const S &x) {
+        auto [l, mr] = split_key(t, x, false);
+        auto [m, r] = split_key(mr, x, true);
+        return {l, m, r};
+    }
+
+    int bound(const S &x, bool inclusive) {
+        int res = 0;
+        for (auto t = root; t;) {
+            push(t);
+            if (inclusive ? !(x < t->val) : t->val < x) {
+                res += count(t->l) + 1;
+                t = t->r;
+            } else {
+                t = t->l;
+            }
+        }
+        return res;
+    }
+
+    void clear(Node *t) {
+        if (!t) return;
+        clear(t->l);
+        clear(t->r);
+        delete t;
+    }
+
+    // In the set operations the root with higher priority becomes the
+    // pivot and the other tree is split around its key.
+
+    Node *unite(Node *a, Node *b) {
+        if (!a || !b) return a ? a : b;
+        if (a->pri < b->pri) std::swap(a, b);
+        push(a);
+        auto [l, r] = split_key(b, a->val, false);
+        a->l = unite(a->l, l);
+        a->r = unite(a->r, r);
+        return update(a);
+    }
+
+    Node *intersect(Node *a, Node *b) {
+        if (!a || !b) {
+            clear(a);
+            clear(b);
+            return nullptr;
+        }
+        if (a->pri > b->pri) {
+            push(a);
+            auto [bl, bm, br] = split_key3(b, a->val);
+            if (!bm) {
+                auto l = intersect(a->l, bl), r = intersect(a->r, br);
+                delete a;
+                return merge(l, r);
+            }
+            clear(bm);
+            auto [al, am1] = split_key(a->l, a->val, false);
+            auto [am2, ar] = split_key(a->r, a->val, true);
+            a->l = am1;
+            a->r = am2;
+            update(a);
+            return merge(merge(intersect(al, bl), a), intersect(ar, br));
+        } else {
+            push(b);
+            auto [al, am, ar] = split_key3(a, b->val);
+            auto l = intersect(al, b->l), r = intersect(ar, b->r);
+            delete b;
+            return merge(merge(l, am), r);
+        }
+    }
+
+    Node *subtract(Node *a, Node *b) {
+        if (!a || !b) {
+            clear(b);
+            return a;
+        }
+        if (a->pri > b->pri) {
+            push(a);
+            auto [bl, bm, br] = split_key3(b, a->val);
+            if (!bm) {
+                a->l = subtract(a->l, bl);
+                a->r = subtract(a->r, br);
+                return update(a);
+            }
+            clear(bm);
+            auto [al, am1] = split_key(a->l, a->val, false);
+            auto [am2, ar] = split_key(a->r, a->val, true);
+            clear(am1);
+            clear(am2);
+            delete a;
+            return merge(subtract(al, bl), subtract(ar, br));
+        } else {
+            push(b);
+            auto [al, am, ar] = split_key3(a, b->val);
+            clear(am);
+            auto l = subtract(al, b->l), r = subtract(ar, b->r);
+            delete b;
+            return merge(l, r);
+        }
+    }
+
+    Node *build(int l, int r, const std::vector<S> &v) {
         if (l == (int)v.size()) return nullptr;
         if (r - l == 1) {
-            auto t = new Node(v[l]);
+            auto t = new Node(v[l], id());
             t->pri = gen();
             return t;
         }
@@ -167,6 +378,10 @@ struct Treap {
     }
 };
 
+template <class S, S (*op)(S, S), S (*e)(), class F, S (*mapping)(F, S),
+          F (*composition)(F, F), F (*id)()>
+using Treap = TreapOf<FunctionAct<S, op, e, F, mapping, composition, id>>;
+
 }  // namespace rklib
 
 #endif  // RK_TREAP_HPP
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define RK_WAVELET_MATRIX_HPP
 
 #include <array>
+#include <cstddef>
 #include <rklib/data_structure/bit_vector.hpp>
 #include <rklib/utility/utility.hpp>
+#include <utility>
 #include <vector>
 
 namespace rklib {
@@ -14,8 +16,9 @@ struct WaveletMatrix {
     WaveletMatrix() : WaveletMatrix(0) {}
     WaveletMatrix(int n) : WaveletMatrix(std::vector<T>(n, 0)) {}
     WaveletMatrix(std::vector<T> a) : n(a.size()) {
-        std::vector<std::vector<T>> b(2, std::vector<T>(n));
-        copy(a.begin(), a.end(), b[(w + 1) & 1].begin());
+        std::vector<std::vector<T>> b(2);
+        b[(w + 1) & 1] = std::move(a);
+        b[w & 1].resize(n);
         for (int i = w - 1; i >= 0; i--) {
             v[i] = {b[i & 1], i};
             int l = 0, r = n - 1;
@@ -66,6 +69,28 @@ struct WaveletMatrix {
         return r - l;
     }
 
+    T access(int i) {
+        T res = 0;
+        for (int k = w - 1; k >= 0; k--) {
+            if (v[k].get(i)) {
+                res |= T(1) << k;
+                i = v[k].rank(n, 0) + v[k].rank(i, 1);
+            } else {
+                i = v[k].rank(i, 0);
+            }
+        }
+        return res;
+    }
+
+    // number of x in [0, i)
+    int rank(T x, int i) { return freq(0, i, x); }
+
+    std::size_t memory_bytes() const {
+        std::size_t res = 0;
+        for (auto &b : v) res += b.memory_bytes();
+        return res;
+    }
+
    private:
     int n;
     std::array<BitVector<T>, w> v;
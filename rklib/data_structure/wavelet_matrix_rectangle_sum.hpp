@@ -0,0 +1,105 @@
+#ifndef RK_WAVELET_MATRIX_RECTANGLE_SUM_HPP
+#define RK_WAVELET_MATRIX_RECTANGLE_SUM_HPP
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <rklib/data_structure/bit_vector.hpp>
+#include <rklib/utility/coordinate_compression.hpp>
+#include <vector>
+
+namespace rklib {
+
+// Static sum of weights of points in [xl, xr) x [yl, yr).
+// Points are sorted by x and their compressed y is stored in a wavelet
+// matrix whose levels also keep prefix sums of the weights.
+template <class T, class W>
+struct WaveletMatrixRectangleSum {
+   public:
+    WaveletMatrixRectangleSum() {}
+    WaveletMatrixRectangleSum(const std::vector<T> &x, const std::vector<T> &y,
+                              const std::vector<W> &w)
+        : n(x.size()) {
+        std::vector<int> ord(n);
+        std::iota(ord.begin(), ord.end(), 0);
+        std::sort(ord.begin(), ord.end(),
+                  [&](int i, int j) { return x[i] < x[j]; });
+        yc = CoordComp<T>(std::vector<T>(y));
+
+        xs.resize(n);
+        std::vector<int> cur(n), nxt(n);
+        std::vector<W> cw(n), nw(n);
+        for (int i = 0; i < n; i++) {
+            xs[i] = x[ord[i]];
+            cur[i] = yc.get_idx(y[ord[i]]);
+            cw[i] = w[ord[i]];
+        }
+
+        lg = 1;
+        while ((1 << lg) <= yc.size()) ++lg;
+        bv.resize(lg);
+        pre.resize(lg, std::vector<W>(n + 1, W(0)));
+        for (int i = lg - 1; i >= 0; i--) {
+            bv[i] = BitVector<int>(cur, i);
+            int z = 0;
+            for (int j = 0; j < n; j++) z += !(cur[j] >> i & 1);
+            for (int j = 0, l = 0, r = z; j < n; j++) {
+                int k = (cur[j] >> i & 1) ? r++ : l++;
+                nxt[k] = cur[j];
+                nw[k] = cw[j];
+            }
+            cur.swap(nxt);
+            cw.swap(nw);
+            for (int j = 0; j < n; j++) pre[i][j + 1] = pre[i][j] + cw[j];
+        }
+    }
+
+    // sum of weights in [xl, xr) x [yl, yr)
+    W sum(T xl, T xr, T yl, T yr) {
+        if (!(xl < xr) || !(yl < yr)) return W(0);
+        int l = std::lower_bound(xs.begin(), xs.end(), xl) - xs.begin();
+        int r = std::lower_bound(xs.begin(), xs.end(), xr) - xs.begin();
+        if (l >= r) return W(0);
+        return sum_lower(l, r, yc.get_idx(yr)) -
+               sum_lower(l, r, yc.get_idx(yl));
+    }
+
+    // rects[i] = {xl, xr, yl, yr}
+    std::vector<W> sum(const std::vector<std::array<T, 4>> &rects) {
+        std::vector<W> res(rects.size());
+        for (size_t i = 0; i < rects.size(); i++) {
+            auto &[xl, xr, yl, yr] = rects[i];
+            res[i] = sum(xl, xr, yl, yr);
+        }
+        return res;
+    }
+
+   private:
+    int n, lg;
+    std::vector<T> xs;
+    CoordComp<T> yc;
+    std::vector<BitVector<int>> bv;
+    std::vector<std::vector<W>> pre;  // prefix sums of the weights per level
+
+    // sum of weights in [l, r) of x-order with compressed y < upper
+    W sum_lower(int l, int r, int upper) {
+        W res(0);
+        for (int i = lg - 1; i >= 0; i--) {
+            int lz = bv[i].rank(l, 0), rz = bv[i].rank(r, 0);
+            if (!(upper >> i & 1)) {
+                l = lz;
+                r = rz;
+            } else {
+                res += pre[i][rz] - pre[i][lz];
+                int t = bv[i].rank(n, 0);
+                l = t + l - lz;
+                r = t + r - rz;
+            }
+        }
+        return res;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_WAVELET_MATRIX_RECTANGLE_SUM_HPP
\ No newline at end of file
@@ -9,32 +9,57 @@
 
 namespace rklib {
 
+namespace dijkstra_internal {
+
+// binary heap with lazy deletion
 template <class T>
+struct LazyHeap {
+   public:
+    LazyHeap(int) {}
+
+    bool empty() { return que.empty(); }
+
+    void push(T key, int v) { que.emplace(key, v); }
+
+    std::pair<T, int> pop() {
+        auto res = que.top();
+        que.pop();
+        return res;
+    }
+
+   private:
+    std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>,
+                        std::greater<std::pair<T, int>>>
+        que;
+};
+
+}  // namespace dijkstra_internal
+
+// Heap: constructed from the vertex count, with push(key, v), pop() and
+// empty(), e.g. RadixHeap<T> or IndexedDAryHeap<T>
+template <class T, class Heap = dijkstra_internal::LazyHeap<T>>
 std::pair<std::vector<T>, std::vector<int>> dijkstra(Graph<T> &gr, int s) {
     constexpr auto INF = std::numeric_limits<T>::max();
     std::vector<T> dist(gr.size(), INF);
     std::vector<int> pre(gr.size(), -1);
-    std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>,
-                        std::greater<std::pair<T, int>>>
-        que;
-    que.emplace(0, s);
+    Heap que(gr.size());
+    que.push(0, s);
     dist[s] = 0;
     while (!que.empty()) {
-        auto [d, v] = que.top();
-        que.pop();
+        auto [d, v] = que.pop();
         if (d > dist[v]) continue;
         for (auto &e : gr[v])
             if (chmin(dist[e.to], dist[v] + e.cost)) {
-                que.emplace(dist[e.to], e.to);
+                que.push(dist[e.to], e.to);
                 pre[e.to] = e.idx;
             }
     }
     return {dist, pre};
 }
 
-template <class T>
+template <class T, class Heap = dijkstra_internal::LazyHeap<T>>
 std::pair<T, std::vector<int>> dijkstra(Graph<T> &gr, int s, int t) {
-    auto [dist, pre] = dijkstra(gr, s);
+    auto [dist, pre] = dijkstra<T, Heap>(gr, s);
     std::vector<int> res;
     auto es = gr.edges();
     for (int e = pre[t]; e >= 0; e = pre[es[e].from]) {
@@ -0,0 +1,223 @@
+#ifndef RK_LINK_CUT_TREE_HPP
+#define RK_LINK_CUT_TREE_HPP
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+template <class S, S (*op)(S, S), S (*e)(), class F, S (*mapping)(F, S),
+          F (*composition)(F, F), F (*id)()>
+struct LinkCutTree {
+   public:
+    LinkCutTree() : LinkCutTree(0) {}
+    LinkCutTree(int n) : LinkCutTree(std::vector<S>(n, e())) {}
+    LinkCutTree(const std::vector<S> &v) : n(v.size()), nodes(v.size()) {
+        for (int i = 0; i < n; i++) nodes[i] = Node(v[i]);
+    }
+
+    // add edge (u, v); u and v must be in different trees
+    void link(int u, int v) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        evert(u);
+        expose(v);
+        assert(nodes[u].p == -1);
+        nodes[u].p = v;
+    }
+
+    // remove edge (u, v); the edge must exist
+    void cut(int u, int v) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        evert(u);
+        expose(v);
+        assert(nodes[v].l == u && nodes[u].r == -1);
+        nodes[v].l = nodes[u].p = -1;
+        update(v);
+    }
+
+    // make v the root of its tree
+    void evert(int v) {
+        assert(0 <= v && v < n);
+        expose(v);
+        toggle(v);
+        push(v);
+    }
+
+    int root(int v) {
+        assert(0 <= v && v < n);
+        expose(v);
+        while (true) {
+            push(v);
+            if (nodes[v].l == -1) break;
+            v = nodes[v].l;
+        }
+        splay(v);
+        return v;
+    }
+
+    bool connected(int u, int v) { return root(u) == root(v); }
+
+    // lca with respect to the current root; u and v must be connected
+    int lca(int u, int v) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        expose(u);
+        return expose(v);
+    }
+
+    S get(int v) {
+        assert(0 <= v && v < n);
+        expose(v);
+        return nodes[v].val;
+    }
+
+    void set(int v, S x) {
+        assert(0 <= v && v < n);
+        expose(v);
+        nodes[v].val = x;
+        update(v);
+    }
+
+    // product of the vertices on the path u -> v
+    S prod(int u, int v) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        evert(u);
+        expose(v);
+        return nodes[v].sum;
+    }
+
+    // apply f to the vertices on the path u - v
+    void apply(int u, int v, F f) {
+        assert(0 <= u && u < n);
+        assert(0 <= v && v < n);
+        evert(u);
+        expose(v);
+        all_apply(v, f);
+    }
+
+   private:
+    struct Node {
+        int l, r, p;
+        S val, sum, rsum;
+        F lazy;
+        bool rev;
+
+        Node(S val = e())
+            : l(-1),
+              r(-1),
+              p(-1),
+              val(val),
+              sum(val),
+              rsum(val),
+              lazy(id()),
+              rev(false) {}
+    };
+
+    int n;
+    std::vector<Node> nodes;
+    std::vector<int> stk;
+
+    bool is_root(int t) {
+        int p = nodes[t].p;
+        return p == -1 || (nodes[p].l != t && nodes[p].r != t);
+    }
+
+    S sum(int t) { return t >= 0 ? nodes[t].sum : e(); }
+
+    S rsum(int t) { return t >= 0 ? nodes[t].rsum : e(); }
+
+    void update(int t) {
+        auto &x = nodes[t];
+        x.sum = op(op(sum(x.l), x.val), sum(x.r));
+        x.rsum = op(op(rsum(x.r), x.val), rsum(x.l));
+    }
+
+    void all_apply(int t, F f) {
+        if (t < 0) return;
+        auto &x = nodes[t];
+        x.val = mapping(f, x.val);
+        x.sum = mapping(f, x.sum);
+        x.rsum = mapping(f, x.rsum);
+        x.lazy = composition(f, x.lazy);
+    }
+
+    void toggle(int t) {
+        if (t < 0) return;
+        auto &x = nodes[t];
+        std::swap(x.l, x.r);
+        std::swap(x.sum, x.rsum);
+        x.rev ^= true;
+    }
+
+    void push(int t) {
+        auto &x = nodes[t];
+        all_apply(x.l, x.lazy);
+        all_apply(x.r, x.lazy);
+        x.lazy = id();
+        if (x.rev) {
+            toggle(x.l);
+            toggle(x.r);
+            x.rev = false;
+        }
+    }
+
+    void rotate(int t) {
+        int p = nodes[t].p, g = nodes[p].p;
+        if (nodes[p].l == t) {
+            nodes[p].l = nodes[t].r;
+            if (nodes[t].r >= 0) nodes[nodes[t].r].p = p;
+            nodes[t].r = p;
+        } else {
+            nodes[p].r = nodes[t].l;
+            if (nodes[t].l >= 0) nodes[nodes[t].l].p = p;
+            nodes[t].l = p;
+        }
+        if (g >= 0) {
+            if (nodes[g].l == p) nodes[g].l = t;
+            if (nodes[g].r == p) nodes[g].r = t;
+        }
+        nodes[p].p = t;
+        nodes[t].p = g;
+        update(p);
+    }
+
+    void splay(int t) {
+        stk.push_back(t);
+        for (int c = t; !is_root(c); c = nodes[c].p) stk.push_back(nodes[c].p);
+        while (!stk.empty()) {
+            push(stk.back());
+            stk.pop_back();
+        }
+        while (!is_root(t)) {
+            int p = nodes[t].p;
+            if (!is_root(p)) {
+                int g = nodes[p].p;
+                rotate((nodes[g].l == p) == (nodes[p].l == t) ? p : t);
+            }
+            rotate(t);
+        }
+        update(t);
+    }
+
+    // make the root-v path preferred; returns the last vertex where the
+    // path switched, which is lca(u, v) right after expose(u)
+    int expose(int v) {
+        int last = -1;
+        for (int c = v; c >= 0; c = nodes[c].p) {
+            splay(c);
+            nodes[c].r = last;
+            update(c);
+            last = c;
+        }
+        splay(v);
+        return last;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_LINK_CUT_TREE_HPP
\ No newline at end of file
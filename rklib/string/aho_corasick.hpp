@@ -0,0 +1,143 @@
+#ifndef RK_AHO_CORASICK_HPP
+#define RK_AHO_CORASICK_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Aho-Corasick over bytes. build() turns the trie into a complete DFA
+// stored as one flat table nxt[v * sigma + class], where the bytes that
+// occur in no pattern share class 0, so a text byte costs one lookup.
+// Matches are enumerated through output links to the nearest terminal
+// suffix state. feed() keeps the state and the position between calls,
+// so a stream can be matched chunk by chunk.
+struct AhoCorasick {
+   public:
+    AhoCorasick() {}
+
+    // returns the id of p; call build() after the last add
+    int add(const std::string &p) {
+        assert(!p.empty());
+        pats.push_back(p);
+        return pats.size() - 1;
+    }
+
+    void build() {
+        cls.fill(0);
+        sigma = 1;
+        for (auto &p : pats)
+            for (char c : p)
+                if (cls[uint8_t(c)] == 0) cls[uint8_t(c)] = sigma++;
+
+        nxt.assign(sigma, -1);
+        term.assign(1, -1);
+        plen.resize(pats.size());
+        pat_next.resize(pats.size());
+        for (int id = 0; id < (int)pats.size(); id++) {
+            int v = 0;
+            for (char c : pats[id]) {
+                int &to = nxt[v * sigma + cls[uint8_t(c)]];
+                if (to < 0) {
+                    to = term.size();
+                    term.push_back(-1);
+                    nxt.resize(nxt.size() + sigma, -1);
+                }
+                v = nxt[v * sigma + cls[uint8_t(c)]];
+            }
+            plen[id] = pats[id].size();
+            pat_next[id] = term[v];
+            term[v] = id;
+        }
+
+        int states = term.size();
+        std::vector<int> fail(states, 0), que(1, 0);
+        out.assign(states, -1);
+        link.assign(states, -1);
+        for (int h = 0; h < (int)que.size(); h++) {
+            int v = que[h];
+            for (int k = 0; k < sigma; k++) {
+                int &u = nxt[v * sigma + k];
+                int f = (v == 0 ? 0 : nxt[fail[v] * sigma + k]);
+                if (u < 0 || k == 0) {
+                    u = f;
+                    continue;
+                }
+                fail[u] = f;
+                link[u] = out[f];
+                out[u] = term[u] >= 0 ? u : link[u];
+                que.push_back(u);
+            }
+        }
+        // renumber in BFS order so the shallow, hot states are adjacent
+        std::vector<int> id(states), t(nxt.size());
+        for (int h = 0; h < states; h++) id[que[h]] = h;
+        for (int h = 0; h < states; h++)
+            for (int k = 0; k < sigma; k++)
+                t[h * sigma + k] = id[nxt[que[h] * sigma + k]];
+        nxt.swap(t);
+        auto perm = [&](std::vector<int> &a, bool is_state) {
+            std::vector<int> b(states);
+            for (int h = 0; h < states; h++) {
+                int x = a[que[h]];
+                b[h] = (is_state && x >= 0) ? id[x] : x;
+            }
+            a.swap(b);
+        };
+        perm(term, false);
+        perm(out, true);
+        perm(link, true);
+        reset();
+    }
+
+    // forget the stream state
+    void reset() {
+        state = 0;
+        pos = 0;
+    }
+
+    // f(id, start) for every occurrence of pattern id ending in chunk;
+    // start is the position in the whole stream
+    template <class F>
+    void feed(const std::string &chunk, F f) {
+        int v = state;
+        for (char c : chunk) {
+            v = nxt[v * sigma + cls[uint8_t(c)]];
+            ++pos;
+            for (int u = out[v]; u >= 0; u = link[u])
+                for (int id = term[u]; id >= 0; id = pat_next[id])
+                    f(id, pos - plen[id]);
+        }
+        state = v;
+    }
+
+    // (start, id) of every occurrence in t, as a fresh stream
+    std::vector<std::pair<long long, int>> find_all(const std::string &t) {
+        std::vector<std::pair<long long, int>> res;
+        reset();
+        feed(t, [&](int id, long long start) { res.emplace_back(start, id); });
+        reset();
+        return res;
+    }
+
+    int size() { return term.size(); }
+
+   private:
+    std::vector<std::string> pats;
+    std::array<int, 256> cls;
+    int sigma = 1;
+    // nxt: DFA, term: last pattern ending at a state (chained through
+    // pat_next), out: the state itself if terminal, else link, link:
+    // nearest proper suffix state that is terminal
+    std::vector<int> nxt, term, out, link, plen, pat_next;
+    int state = 0;
+    long long pos = 0;
+};
+
+}  // namespace rklib
+
+#endif  // RK_AHO_CORASICK_HPP
\ No newline at end of file
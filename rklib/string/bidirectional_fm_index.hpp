@@ -0,0 +1,193 @@
+#ifndef RK_BIDIRECTIONAL_FM_INDEX_HPP
+#define RK_BIDIRECTIONAL_FM_INDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <rklib/data_structure/bit_vector.hpp>
+#include <rklib/string/suffix_array.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rklib {
+
+// FM-indexes of s and of reverse(s) with synchronized intervals, so a
+// match can be extended both to the left and to the right. Approximate
+// search uses the pigeonhole search scheme: the pattern is cut into
+// k + 1 parts and search i matches part i exactly, extends to the right
+// through parts i + 1, ... and then to the left through parts i - 1,
+// ..., 0 with up to k errors. A text symbol outside [cmin, cmax] throws
+// std::invalid_argument.
+template <char cmin = 'a', char cmax = 'z'>
+struct BidirectionalFMIndex {
+   public:
+    BidirectionalFMIndex() {}
+    BidirectionalFMIndex(const std::string &s) : n(s.size() + 1) {
+        std::vector<int> v(s.size());
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] < cmin || cmax < s[i])
+                throw std::invalid_argument(
+                    "BidirectionalFMIndex: symbol out of range at " +
+                    std::to_string(i));
+            v[i] = code(s[i]);
+        }
+        sa = suffix_array(v, cnum - 1);
+        fwd = Side(v, sa);
+        sa.insert(sa.begin(), n - 1);
+        std::reverse(v.begin(), v.end());
+        bwd = Side(v, suffix_array(v, cnum - 1));
+
+        cnt_smaller.assign(cnum + 1, 0);
+        cnt_smaller[0] = 1;
+        for (int c : v) ++cnt_smaller[c + 1];
+        std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
+                         cnt_smaller.begin());
+    }
+
+    // sorted start positions of exact occurrences of p
+    std::vector<int> find_all(const std::string &p) {
+        return find_all_mismatch(p, 0);
+    }
+
+    // sorted start positions i with s[i, i + |p|) at Hamming distance <= k
+    std::vector<int> find_all_mismatch(const std::string &p, int k) {
+        return search(p, k, false);
+    }
+
+    // sorted start positions i such that some s[i, j) is at edit distance
+    // <= k from p
+    std::vector<int> find_all_edit(const std::string &p, int k) {
+        return search(p, k, true);
+    }
+
+   private:
+    // [l, l + size) in the index of s and [rl, rl + size) in the index of
+    // reverse(s)
+    struct Interval {
+        int l, rl, size;
+    };
+
+    // BWT of one direction, one bit vector per symbol
+    struct Side {
+        int primary = 0;
+        std::vector<BitVector<int>> occ;
+
+        Side() {}
+        // sa: suffix array of v without the sentinel
+        Side(const std::vector<int> &v, std::vector<int> sa) {
+            int n = v.size() + 1;
+            sa.insert(sa.begin(), n - 1);
+            occ.resize(cnum);
+            std::vector<std::vector<int>> b(cnum, std::vector<int>(n, 0));
+            for (int i = 0; i < n; i++) {
+                if (sa[i] == 0)
+                    primary = i;
+                else
+                    b[v[sa[i] - 1]][i] = 1;
+            }
+            for (int c = 1; c < cnum; c++) occ[c] = BitVector<int>(b[c]);
+        }
+
+        int rank(int c, int i) {
+            return c == 0 ? (primary < i) : occ[c].rank(i, 1);
+        }
+    };
+
+    static constexpr int cnum = (cmax - cmin) + 2;
+    int n = 0;
+    std::vector<int> sa, cnt_smaller;
+    Side fwd, bwd;
+
+    // 1..cnum-1 for [cmin, cmax], 0 (never matched) otherwise
+    static int code(char c) {
+        return (cmin <= c && c <= cmax) ? (c - cmin) + 1 : 0;
+    }
+
+    // res[c] = the interval extended by c on the left (right if !left),
+    // for every symbol c
+    void extend_all(const Interval &it, bool left, Interval res[]) {
+        Side &a = left ? fwd : bwd;
+        int lo = left ? it.l : it.rl;
+        int other = left ? it.rl : it.l;
+        int smaller = a.rank(0, lo + it.size) - a.rank(0, lo);
+        for (int c = 1; c < cnum; c++) {
+            int x = a.rank(c, lo), y = a.rank(c, lo + it.size);
+            int nl = cnt_smaller[c] + x, no = other + smaller;
+            res[c] = left ? Interval{nl, no, y - x} : Interval{no, nl, y - x};
+            smaller += y - x;
+        }
+    }
+
+    struct Step {
+        int j;
+        bool left;
+        int upper;
+    };
+
+    std::vector<int> search(const std::string &p, int k, bool edit) {
+        const int m = p.size();
+        std::vector<int> res;
+        if (k >= m) {
+            // everything is within distance k
+            int last = edit ? n - 1 : n - 1 - m;
+            for (int i = 0; i <= last; i++) res.push_back(i);
+            return res;
+        }
+        const int parts = k + 1;
+        std::vector<int> bound(parts + 1);
+        for (int i = 0; i <= parts; i++) bound[i] = m * i / parts;
+        for (int first = 0; first < parts; first++) {
+            std::vector<Step> steps;
+            for (int q = first; q < parts; q++)
+                for (int j = bound[q]; j < bound[q + 1]; j++)
+                    steps.push_back({j, false, q == first ? 0 : k});
+            for (int q = first - 1; q >= 0; q--)
+                for (int j = bound[q + 1] - 1; j >= bound[q]; j--)
+                    steps.push_back({j, true, k});
+            rec(p, steps, 0, Interval{0, 0, n}, 0, k, edit, res);
+        }
+        std::sort(res.begin(), res.end());
+        res.erase(std::unique(res.begin(), res.end()), res.end());
+        return res;
+    }
+
+    void rec(const std::string &p, const std::vector<Step> &steps, int t,
+             const Interval &it, int e, int k, bool edit,
+             std::vector<int> &res) {
+        if (it.size == 0) return;
+        if (t == (int)steps.size()) {
+            report(it, e, k, edit, res);
+            return;
+        }
+        auto [j, left, upper] = steps[t];
+        std::array<Interval, cnum> next;
+        extend_all(it, left, next.data());
+        int pc = code(p[j]);
+        for (int c = 1; c < cnum; c++) {
+            int ne = e + (c != pc);
+            if (ne <= upper) rec(p, steps, t + 1, next[c], ne, k, edit, res);
+        }
+        if (!edit || e + 1 > upper) return;
+        // p[j] is not in the text
+        rec(p, steps, t + 1, it, e + 1, k, edit, res);
+        // a text character not in p, met before p[j]
+        for (int c = 1; c < cnum; c++)
+            rec(p, steps, t, next[c], e + 1, k, edit, res);
+    }
+
+    // with edits, extra text characters before p may still be spent
+    void report(const Interval &it, int e, int k, bool edit,
+                std::vector<int> &res) {
+        if (it.size == 0) return;
+        for (int i = it.l; i < it.l + it.size; i++) res.push_back(sa[i]);
+        if (!edit || e == k) return;
+        std::array<Interval, cnum> next;
+        extend_all(it, true, next.data());
+        for (int c = 1; c < cnum; c++) report(next[c], e + 1, k, edit, res);
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_BIDIRECTIONAL_FM_INDEX_HPP
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <atcoder/string>
 #include <rklib/data_structure/bit_vector.hpp>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace rklib {
@@ -12,32 +13,17 @@ template <char cmin = 'a', char cmax = 'z', size_t step = 1>
 struct BurrowsWheelerTransform {
    public:
     BurrowsWheelerTransform(std::string &s) : n(s.size() + 1) {
-        std::vector<int> v(s.size());
-        for (size_t i = 0; i < s.size(); i++) {
-            v[i] = (s[i] - cmin) + 1;
-        }
+        auto v = encode(s);
         sa = atcoder::suffix_array(v);
-        v.push_back(0);
-        sa.insert(sa.begin(), n - 1);
-        bwt.resize(n);
-        for (size_t i = 0; i < n; ++i) {
-            bwt[i] = (sa[i] == 0 ? v[n - 1] : v[sa[i] - 1]);
-        }
+        build(v);
+    }
 
-        cnt_smaller.resize(cnum, 0);
-        cnt.resize(cnum);
-        for (size_t c = 0; c < cnum; ++c) cnt[c].resize((n + 1) / step + 1, 0);
-        std::vector<int> table(cnum, 0);
-        for (size_t i = 0; i < n; ++i) {
-            if (bwt[i] + 1 < (int)cnum) ++cnt_smaller[bwt[i] + 1];
-            ++table[bwt[i]];
-            if ((i + 1) % step == 0) {
-                for (size_t c = 0; c < cnum; ++c)
-                    cnt[c][(i + 1) / step] = table[c];
-            }
-        }
-        std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
-                         cnt_smaller.begin());
+    // sa_first: the suffix array of s, e.g. a MappedFile written by
+    // build_external_suffix_array
+    template <class It>
+    BurrowsWheelerTransform(std::string &s, It sa_first)
+        : n(s.size() + 1), sa(sa_first, sa_first + s.size()) {
+        build(encode(s));
     }
 
     std::pair<int, int> fm_index(std::string &s) {
@@ -62,28 +48,96 @@ struct BurrowsWheelerTransform {
         return r - l > 0;
     }
 
+    // fm_index of every pattern, in input order, with the same bounds as
+    // fm_index also when a pattern does not occur. Groups of batch_width
+    // patterns advance their backward searches in lockstep and prefetch
+    // the count entries of their next step, so the cache misses of a
+    // group overlap. The groups are split over num_threads threads.
+    std::vector<std::pair<int, int>> fm_index_batch(
+        const std::vector<std::string> &ps, int num_threads = 1) {
+        std::vector<std::pair<int, int>> res(ps.size());
+        int m = ps.size(), groups = (m + batch_width - 1) / batch_width;
+        auto work = [&](int t) {
+            for (int g = groups * t / num_threads;
+                 g < groups * (t + 1) / num_threads; g++) {
+                search_group(ps, res, g * batch_width,
+                             std::min(m, (g + 1) * batch_width));
+            }
+        };
+        if (num_threads <= 1) {
+            num_threads = 1;
+            work(0);
+        } else {
+            std::vector<std::thread> ths;
+            for (int t = 0; t < num_threads; t++) ths.emplace_back(work, t);
+            for (auto &th : ths) th.join();
+        }
+        return res;
+    }
+
+    std::vector<int> count_batch(const std::vector<std::string> &ps,
+                                 int num_threads = 1) {
+        auto iv = fm_index_batch(ps, num_threads);
+        std::vector<int> res(iv.size());
+        for (size_t i = 0; i < iv.size(); i++)
+            res[i] = iv[i].second - iv[i].first;
+        return res;
+    }
+
    private:
+    static constexpr int batch_width = 16;
     const size_t cnum = (cmax - cmin) + 2;
     size_t n;
     std::vector<int> bwt, cnt_smaller, sa;
     std::vector<std::vector<int>> cnt;
 
+    void prefetch(int c, int k) {
+        __builtin_prefetch(&cnt[c][k / step]);
+        if (step > 1) __builtin_prefetch(&bwt[k / step * step]);
+    }
+
+    // backward search of ps[lo, hi) in lockstep
+    void search_group(const std::vector<std::string> &ps,
+                      std::vector<std::pair<int, int>> &res, int lo, int hi) {
+        int pos[batch_width], act[batch_width], k = 0;
+        for (int i = lo; i < hi; i++) {
+            res[i] = {0, (int)n};
+            pos[i - lo] = ps[i].size();
+            if (pos[i - lo] > 0) act[k++] = i;
+        }
+        while (k > 0) {
+            int nk = 0;
+            for (int j = 0; j < k; j++) {
+                int i = act[j], &p = pos[i - lo];
+                auto &[l, r] = res[i];
+                int c = (ps[i][--p] - cmin) + 1;
+                l = cnt_smaller[c] + get_cnt(c, l);
+                r = cnt_smaller[c] + get_cnt(c, r);
+                if (p == 0) continue;
+                int nc = (ps[i][p - 1] - cmin) + 1;
+                prefetch(nc, l);
+                prefetch(nc, r);
+                act[nk++] = i;
+            }
+            k = nk;
+        }
+    }
+
     int get_cnt(int c, int k) {
         int ret = cnt[c][k / step];
         for (int i = k / step * step; i < k; ++i) ret += (bwt[i] == c);
         return ret;
     }
-};
 
-template <char cmin = 'a', char cmax = 'z'>
-struct BurrowsWheelerTransformBitVector {
-   public:
-    BurrowsWheelerTransformBitVector(std::string &s) : n(s.size() + 1) {
+    static std::vector<int> encode(const std::string &s) {
         std::vector<int> v(s.size());
         for (size_t i = 0; i < s.size(); i++) {
             v[i] = (s[i] - cmin) + 1;
         }
-        sa = atcoder::suffix_array(v);
+        return v;
+    }
+
+    void build(std::vector<int> v) {
         v.push_back(0);
         sa.insert(sa.begin(), n - 1);
         bwt.resize(n);
@@ -91,22 +145,39 @@ struct BurrowsWheelerTransformBitVector {
             bwt[i] = (sa[i] == 0 ? v[n - 1] : v[sa[i] - 1]);
         }
 
-        vs.resize(cnum);
-        for (size_t c = 1; c < cnum; c++) {
-            std::vector<int> b(n, 0);
-            for (size_t i = 0; i < n; i++) {
-                if (bwt[i] == int(c)) b[i] = 1;
-            }
-            vs[c] = {b};
-        }
-
         cnt_smaller.resize(cnum, 0);
+        cnt.resize(cnum);
+        for (size_t c = 0; c < cnum; ++c) cnt[c].resize((n + 1) / step + 1, 0);
+        std::vector<int> table(cnum, 0);
         for (size_t i = 0; i < n; ++i) {
             if (bwt[i] + 1 < (int)cnum) ++cnt_smaller[bwt[i] + 1];
+            ++table[bwt[i]];
+            if ((i + 1) % step == 0) {
+                for (size_t c = 0; c < cnum; ++c)
+                    cnt[c][(i + 1) / step] = table[c];
+            }
         }
         std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
                          cnt_smaller.begin());
     }
+};
+
+template <char cmin = 'a', char cmax = 'z'>
+struct BurrowsWheelerTransformBitVector {
+   public:
+    BurrowsWheelerTransformBitVector(std::string &s) : n(s.size() + 1) {
+        auto v = encode(s);
+        sa = atcoder::suffix_array(v);
+        build(v);
+    }
+
+    // sa_first: the suffix array of s, e.g. a MappedFile written by
+    // build_external_suffix_array
+    template <class It>
+    BurrowsWheelerTransformBitVector(std::string &s, It sa_first)
+        : n(s.size() + 1), sa(sa_first, sa_first + s.size()) {
+        build(encode(s));
+    }
 
     std::pair<int, int> fm_index(std::string &s) {
         int l = 0, r = n;
@@ -135,6 +206,39 @@ struct BurrowsWheelerTransformBitVector {
     size_t n;
     std::vector<int> bwt, cnt_smaller, sa;
     std::vector<BitVector<int>> vs;
+
+    static std::vector<int> encode(const std::string &s) {
+        std::vector<int> v(s.size());
+        for (size_t i = 0; i < s.size(); i++) {
+            v[i] = (s[i] - cmin) + 1;
+        }
+        return v;
+    }
+
+    void build(std::vector<int> v) {
+        v.push_back(0);
+        sa.insert(sa.begin(), n - 1);
+        bwt.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            bwt[i] = (sa[i] == 0 ? v[n - 1] : v[sa[i] - 1]);
+        }
+
+        vs.resize(cnum);
+        for (size_t c = 1; c < cnum; c++) {
+            std::vector<int> b(n, 0);
+            for (size_t i = 0; i < n; i++) {
+                if (bwt[i] == int(c)) b[i] = 1;
+            }
+            vs[c] = {b};
+        }
+
+        cnt_smaller.resize(cnum, 0);
+        for (size_t i = 0; i < n; ++i) {
+            if (bwt[i] + 1 < (int)cnum) ++cnt_smaller[bwt[i] + 1];
+        }
+        std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
+                         cnt_smaller.begin());
+    }
 };
 
 }  // namespace rklib
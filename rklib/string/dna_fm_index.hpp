@@ -0,0 +1,161 @@
+#ifndef RK_DNA_FM_INDEX_HPP
+#define RK_DNA_FM_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <rklib/data_structure/bit_vector.hpp>
+#include <rklib/string/suffix_array.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rklib {
+
+// FM-index over ACGT (either case); any other symbol in the text, such
+// as N, throws std::invalid_argument. The BWT is packed 2 bits per base
+// in 64-byte blocks, each holding the occurrence counts of the 4 bases
+// before the block and the next 192 bases, so a rank is one cache line:
+// a counter plus popcounts over at most 6 words. The sentinel is stored
+// as A at row primary and corrected for in rank. The suffix array is
+// sampled as in FMIndex.
+struct DNAFMIndex {
+   public:
+    DNAFMIndex() {}
+    DNAFMIndex(const std::string &s, int sample_rate = 32) : n(s.size() + 1) {
+        std::vector<uint8_t> v(s.size());
+        for (size_t i = 0; i < s.size(); i++) {
+            v[i] = code(s[i]);
+            if (v[i] >= 4)
+                throw std::invalid_argument("DNAFMIndex: not ACGT at " +
+                                            std::to_string(i));
+        }
+        // row 0 is the sentinel suffix, row i > 0 is sa[i - 1]
+        blocks.resize(n / per_block + 1);
+        sampled = BitVector<int>(n);
+        {
+            auto sa = SuffixArrayBuilder<int>().build(v, 3);
+            uint32_t occ[4] = {0, 0, 0, 0};
+            for (int i = 0; i < n; i++) {
+                auto &b = blocks[i / per_block];
+                int k = i % per_block;
+                if (k == 0) std::copy(occ, occ + 4, b.occ);
+                int p = i == 0 ? n - 1 : sa[i - 1], c = 0;
+                if (p == 0)
+                    primary = i;
+                else
+                    c = v[p - 1];
+                b.bits[k / 32] |= uint64_t(c) << (2 * (k % 32));
+                ++occ[c];
+                if (p % sample_rate == 0) {
+                    sampled.set(i);
+                    samples.push_back(p);
+                }
+            }
+            if (n % per_block == 0)
+                std::copy(occ, occ + 4, blocks.back().occ);
+        }
+        sampled.build();
+
+        cnt_smaller.assign(5, 0);
+        cnt_smaller[0] = 1;
+        for (auto c : v) ++cnt_smaller[c + 1];
+        std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
+                         cnt_smaller.begin());
+    }
+
+    // range of rows prefixed by p
+    std::pair<int, int> fm_index(const std::string &p) {
+        int l = 0, r = n;
+        for (int i = (int)p.size() - 1; i >= 0 && l < r; --i) {
+            int c = code(p[i]);
+            if (c >= 4) return {0, 0};
+            l = cnt_smaller[c] + rank(c, l);
+            r = cnt_smaller[c] + rank(c, r);
+        }
+        return {l, r};
+    }
+
+    int count(const std::string &p) {
+        auto [l, r] = fm_index(p);
+        return r - l;
+    }
+
+    bool contains(const std::string &p) { return count(p) > 0; }
+
+    std::vector<int> find_all(const std::string &p) {
+        auto [l, r] = fm_index(p);
+        std::vector<int> res;
+        for (int i = l; i < r; i++) res.push_back(locate(i));
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    // text position of row i
+    int locate(int i) {
+        int steps = 0;
+        while (!sampled.get(i)) {
+            int c = access(i);
+            i = cnt_smaller[c] + rank(c, i);
+            ++steps;
+        }
+        return samples[sampled.rank(i, 1)] + steps;
+    }
+
+    std::size_t memory_bytes() const {
+        return blocks.size() * sizeof(Block) + sampled.memory_bytes() +
+               samples.size() * sizeof(int) +
+               cnt_smaller.size() * sizeof(int);
+    }
+
+    double bits_per_symbol() const { return 8.0 * memory_bytes() / n; }
+
+   private:
+    static constexpr int per_block = 192;
+    struct alignas(64) Block {
+        uint32_t occ[4];
+        uint64_t bits[6];
+    };
+    static constexpr uint64_t lo_bits = 0x5555555555555555ULL;
+
+    int n = 0, primary = 0;
+    std::vector<Block> blocks;
+    BitVector<int> sampled;
+    std::vector<int> samples, cnt_smaller;
+
+    // 0-3 for ACGT, 4 otherwise
+    static int code(char c) {
+        const char *acgt = "ACGT";
+        for (int k = 0; k < 4; k++)
+            if (c == acgt[k] || c == acgt[k] + 32) return k;
+        return 4;
+    }
+
+    // number of c in the first len bases of word
+    static int count_word(uint64_t word, int c, int len) {
+        uint64_t x = word ^ (lo_bits * c);
+        uint64_t m = ~(x | (x >> 1)) & lo_bits;
+        if (len < 32) m &= (uint64_t(1) << (2 * len)) - 1;
+        return __builtin_popcountll(m);
+    }
+
+    int rank(int c, int i) {
+        const Block &b = blocks[i / per_block];
+        int k = i % per_block, res = b.occ[c];
+        for (int w = 0; w < k / 32; w++) res += count_word(b.bits[w], c, 32);
+        if (k % 32) res += count_word(b.bits[k / 32], c, k % 32);
+        if (c == 0 && primary < i) --res;
+        return res;
+    }
+
+    int access(int i) {
+        const Block &b = blocks[i / per_block];
+        int k = i % per_block;
+        return b.bits[k / 32] >> (2 * (k % 32)) & 3;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_DNA_FM_INDEX_HPP
\ No newline at end of file
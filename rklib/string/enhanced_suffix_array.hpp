@@ -0,0 +1,140 @@
+#ifndef RK_ENHANCED_SUFFIX_ARRAY_HPP
+#define RK_ENHANCED_SUFFIX_ARRAY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <rklib/data_structure/disjoint_sparse_table.hpp>
+#include <rklib/string/suffix_array.hpp>
+#include <string>
+#include <vector>
+
+namespace rklib {
+
+// Suffix array, its inverse and LCP array with O(1) range minimum on
+// the LCP array (disjoint sparse table, O(n log n) memory).
+// Bytes are compared as unsigned char.
+struct EnhancedSuffixArray {
+   public:
+    std::vector<int> sa, rnk, lcp;  // lcp[i] = LCP(sa[i], sa[i + 1])
+
+    EnhancedSuffixArray() {}
+    EnhancedSuffixArray(const std::string &s) : n(s.size()), s(s) {
+        sa = suffix_array(s);
+        rnk.resize(n);
+        for (int i = 0; i < n; i++) rnk[sa[i]] = i;
+        lcp.resize(std::max(n - 1, 0));
+        for (int i = 0, h = 0; i < n; i++) {
+            if (h > 0) --h;
+            if (rnk[i] == 0) continue;
+            int j = sa[rnk[i] - 1];
+            while (i + h < n && j + h < n && s[i + h] == s[j + h]) ++h;
+            lcp[rnk[i] - 1] = h;
+        }
+        rmq = DisjointSparseTableOf<MinMonoid>(lcp);
+    }
+
+    // length of the longest common prefix of the suffixes i and j
+    int lce(int i, int j) {
+        assert(0 <= i && i <= n && 0 <= j && j <= n);
+        if (i == n || j == n) return 0;
+        if (i == j) return n - i;
+        return lcp_rank(std::min(rnk[i], rnk[j]), std::max(rnk[i], rnk[j]));
+    }
+
+    // sign of the comparison of s[l1, r1) and s[l2, r2)
+    int compare_substrings(int l1, int r1, int l2, int r2) {
+        assert(0 <= l1 && l1 <= r1 && r1 <= n);
+        assert(0 <= l2 && l2 <= r2 && r2 <= n);
+        int len1 = r1 - l1, len2 = r2 - l2;
+        int h = std::min(lce(l1, l2), std::min(len1, len2));
+        if (h == std::min(len1, len2)) return (len1 > len2) - (len1 < len2);
+        return rnk[l1] < rnk[l2] ? -1 : 1;
+    }
+
+    // range [l, r) of sa whose suffixes start with p, O(|p| + log n)
+    std::pair<int, int> find(const std::string &p) {
+        return {bound(p, false), bound(p, true)};
+    }
+
+    int count(const std::string &p) {
+        auto [l, r] = find(p);
+        return r - l;
+    }
+
+    std::vector<int> find_all(const std::string &p) {
+        auto [l, r] = find(p);
+        std::vector<int> res(sa.begin() + l, sa.begin() + r);
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+   private:
+    struct MinMonoid {
+        using S = int;
+        static S op(S a, S b) { return std::min(a, b); }
+        static S e() { return INT_MAX; }
+    };
+
+    int n = 0;
+    std::string s;
+    DisjointSparseTableOf<MinMonoid> rmq;
+
+    // LCP of the suffixes of rank a < b
+    int lcp_rank(int a, int b) { return rmq.prod(a, b); }
+
+    // First rank whose suffix, cut to |p| characters, is >= p (> p if
+    // upper). Binary search keeping the LCP of p with both ends; the LCP
+    // between the middle and the end with the longer match decides the
+    // side without looking at the text, so every character of p is
+    // compared successfully at most once.
+    int bound(const std::string &p, bool upper) {
+        const int m = p.size();
+        int lo = -1, hi = n, l = 0, r = 0;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2, h;
+            if (l >= r) {
+                int x = lo < 0 ? l : lcp_rank(lo, mid);
+                if (x < l) {
+                    hi = mid, r = x;
+                    continue;
+                }
+                if (x > l) {
+                    lo = mid;
+                    continue;
+                }
+                h = l;
+            } else {
+                int x = hi >= n ? r : lcp_rank(mid, hi);
+                if (x < r) {
+                    lo = mid, l = x;
+                    continue;
+                }
+                if (x > r) {
+                    hi = mid;
+                    continue;
+                }
+                h = r;
+            }
+            int i = sa[mid];
+            while (h < m && i + h < n && s[i + h] == p[h]) ++h;
+            bool left;
+            if (h == m)
+                left = upper;
+            else if (i + h == n)
+                left = true;
+            else
+                left = uint8_t(s[i + h]) < uint8_t(p[h]);
+            if (left)
+                lo = mid, l = h;
+            else
+                hi = mid, r = h;
+        }
+        return hi;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_ENHANCED_SUFFIX_ARRAY_HPP
\ No newline at end of file
@@ -0,0 +1,363 @@
+#ifndef RK_EXTERNAL_SUFFIX_ARRAY_HPP
+#define RK_EXTERNAL_SUFFIX_ARRAY_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <rklib/data_structure/wavelet_matrix.hpp>
+#include <rklib/string/suffix_array.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Read-only memory mapping of a file as an array of T (POSIX).
+template <class T>
+struct MappedFile {
+   public:
+    MappedFile() {}
+    MappedFile(const std::string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        if (ok && st.st_size > 0) {
+            void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            ok = (p != MAP_FAILED);
+            if (ok) {
+                ptr = static_cast<const T *>(p);
+                bytes = st.st_size;
+            }
+        }
+        close(fd);
+        if (!ok) throw std::runtime_error("cannot map " + path);
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&o) noexcept : ptr(o.ptr), bytes(o.bytes) {
+        o.ptr = nullptr;
+        o.bytes = 0;
+    }
+    MappedFile &operator=(MappedFile &&o) noexcept {
+        if (this != &o) {
+            unmap();
+            std::swap(ptr, o.ptr);
+            std::swap(bytes, o.bytes);
+        }
+        return *this;
+    }
+    ~MappedFile() { unmap(); }
+
+    size_t size() const { return bytes / sizeof(T); }
+    const T *data() const { return ptr; }
+    const T *begin() const { return ptr; }
+    const T *end() const { return ptr + size(); }
+    const T &operator[](size_t i) const { return ptr[i]; }
+
+   private:
+    const T *ptr = nullptr;
+    size_t bytes = 0;
+
+    void unmap() {
+        if (ptr) munmap(const_cast<T *>(ptr), bytes);
+        ptr = nullptr;
+        bytes = 0;
+    }
+};
+
+namespace external_suffix_array_internal {
+
+// Buffered sequential writer of a raw array of T.
+template <class T>
+struct FileWriter {
+   public:
+    FileWriter(const std::string &path)
+        : path(path), out(path, std::ios::binary) {
+        if (!out) throw std::runtime_error("cannot write " + path);
+        buf.reserve(1 << 16);
+    }
+
+    void push(const T &x) {
+        buf.push_back(x);
+        if (buf.size() == buf.capacity()) flush();
+    }
+
+    void close() {
+        flush();
+        out.close();
+        if (!out) throw std::runtime_error("cannot write " + path);
+    }
+
+   private:
+    std::string path;
+    std::ofstream out;
+    std::vector<T> buf;
+
+    void flush() {
+        out.write(reinterpret_cast<const char *>(buf.data()),
+                  buf.size() * sizeof(T));
+        buf.clear();
+    }
+};
+
+inline bool get_bit(const MappedFile<uint8_t> &f, size_t i) {
+    return f[i >> 3] >> (i & 7) & 1;
+}
+
+// Writes bit x = (suffix x > suffix e) for x in [b, n), 0 elsewhere, 8
+// per byte. Unless e = n, prev_path holds the bits for suffix e + m and
+// m >= e - b: suffix x is matched against s[e, e + m) by the Z-algorithm
+// and a full match is decided by bit x + m of prev_path.
+template <class Index>
+void write_gt(const uint8_t *s, Index n, Index b, Index e, Index m,
+              const std::string &prev_path, const std::string &out_path) {
+    const uint8_t *p = s + e;
+    std::vector<Index> z(m);
+    if (m > 0) z[0] = m;
+    for (Index i = 1, l = 0, r = 0; i < m; i++) {
+        Index h = i < r ? std::min(z[i - l], r - i) : 0;
+        while (i + h < m && p[h] == p[i + h]) ++h;
+        z[i] = h;
+        if (i + h > r) l = i, r = i + h;
+    }
+    MappedFile<uint8_t> prev;
+    if (e < n) prev = MappedFile<uint8_t>(prev_path);
+
+    // s[l, r) = p[0, r - l)
+    Index l = 0, r = 0;
+    auto greater = [&](Index x) {
+        if (x < b || x == e) return false;
+        if (e == n) return true;
+        Index h = x < r ? std::min(z[x - l], r - x) : 0;
+        if (x + h >= r) {
+            while (h < m && x + h < n && s[x + h] == p[h]) ++h;
+            l = x, r = x + h;
+        }
+        if (h == m) return x + m < n && get_bit(prev, x + m);
+        return x + h < n && s[x + h] > p[h];
+    };
+    FileWriter<uint8_t> out(out_path);
+    uint8_t byte = 0;
+    for (Index x = 0; x < n; x++) {
+        byte |= uint8_t(greater(x)) << (x & 7);
+        if ((x & 7) == 7 || x + 1 == n) {
+            out.push(byte);
+            byte = 0;
+        }
+    }
+    out.close();
+}
+
+// Suffix array of s[0, n) into sa_path, blocks of block suffixes
+// processed from the right. With gt[x] = (suffix x > suffix e) for the
+// block [b, e), the block suffixes compare like the suffixes of the
+// string 3 s[i] + 2 gt[i + 1] (3 s[e - 1] + 1 at the end): a tie on the
+// bytes is decided by gt, and the only symbol of the middle kind ends
+// the shorter suffix.
+template <class Index>
+void sort_blockwise(const uint8_t *s, Index n, Index block,
+                    const std::string &sa_path) {
+    const std::string tmp_path = sa_path + ".tmp",
+                      gt_path[2] = {sa_path + ".gt0", sa_path + ".gt1"};
+    FileWriter<Index>(sa_path).close();
+    SuffixArrayBuilder<int> builder;
+    int cur = 0;
+    for (Index e = n, m_prev = 0; e > 0; cur ^= 1) {
+        const Index b = std::max<Index>(e - block, 0);
+        const int m = e - b;
+        write_gt(s, n, b, e, m_prev, gt_path[cur ^ 1], gt_path[cur]);
+        MappedFile<uint8_t> gt(gt_path[cur]);
+
+        std::vector<int> sa;
+        {
+            std::vector<uint16_t> x(m);
+            for (int i = 0; i + 1 < m; i++)
+                x[i] = 3 * s[b + i] + 2 * get_bit(gt, b + i + 1);
+            x[m - 1] = 3 * s[e - 1] + 1;
+            sa = builder.build(x, 3 * 255 + 2);
+        }
+
+        // gap[k]: suffixes right of the block between the block suffixes
+        // of rank k - 1 and k, by LF-mapping over the BWT of the block;
+        // suffix e, the only one not in the block, is placed by gt
+        std::vector<Index> gap(m + 1, 0);
+        {
+            std::vector<uint8_t> bwt(m, 0);
+            int primary = 0;
+            for (int k = 0; k < m; k++) {
+                if (sa[k] == 0)
+                    primary = k;
+                else
+                    bwt[k] = s[b + sa[k] - 1];
+            }
+            WaveletMatrix<uint8_t, 8> wm(std::move(bwt));
+            std::vector<int> cnt(257, 0);
+            for (int i = 0; i < m; i++) ++cnt[s[b + i] + 1];
+            std::partial_sum(cnt.begin(), cnt.end(), cnt.begin());
+            int r = 0;  // the empty suffix
+            for (Index t = n - 1; t >= e; t--) {
+                int c = s[t];
+                r = cnt[c] + wm.rank(c, r) - (c == 0 && primary < r) +
+                    (c == s[e - 1] && t + 1 < n && get_bit(gt, t + 1));
+                ++gap[r];
+            }
+        }
+
+        {
+            MappedFile<Index> right(sa_path);
+            FileWriter<Index> out(tmp_path);
+            Index j = 0;
+            for (int k = 0; k <= m; k++) {
+                for (Index g = 0; g < gap[k]; g++) out.push(right[j++]);
+                if (k < m) out.push(b + sa[k]);
+            }
+            out.close();
+        }
+        if (std::rename(tmp_path.c_str(), sa_path.c_str()) != 0)
+            throw std::runtime_error("cannot write " + sa_path);
+        m_prev = m;
+        e = b;
+    }
+    std::remove(gt_path[0].c_str());
+    std::remove(gt_path[1].c_str());
+}
+
+}  // namespace external_suffix_array_internal
+
+// LCP array of the text in text_path and its suffix array in sa_path
+// (raw Index arrays, e.g. from build_external_suffix_array) by the Phi
+// algorithm, in chunks of about memory_limit / (3 sizeof(Index)) entries:
+// the PLCP array is computed for one range of text positions at a time,
+// each from one sequential scan of the suffix array, and written in text
+// order to lcp_path + ".plcp"; then every range of rows of the suffix
+// array sorts its (sa[i], i) pairs and reads its PLCP values in
+// increasing position. The text and the files are mapped; if everything
+// fits in one chunk, the PLCP array stays in memory. Throws
+// std::runtime_error if the suffix array does not have one entry in
+// [0, n) per byte of the text.
+template <class Index = int>
+void build_lcp_file(const std::string &text_path, const std::string &sa_path,
+                    const std::string &lcp_path,
+                    size_t memory_limit = size_t(1) << 30) {
+    using external_suffix_array_internal::FileWriter;
+    MappedFile<uint8_t> text(text_path);
+    MappedFile<Index> sa(sa_path);
+    if (text.size() > size_t(std::numeric_limits<Index>::max()))
+        throw std::runtime_error("text too long for Index: " + text_path);
+    if (sa.size() != text.size())
+        throw std::runtime_error("suffix array length mismatch: " + sa_path);
+    const Index n = text.size();
+    const uint8_t *s = text.data();
+    FileWriter<Index> out(lcp_path);
+    if (n == 0) {
+        out.close();
+        return;
+    }
+    const Index chunk = std::min<size_t>(
+        std::max<size_t>(memory_limit / (3 * sizeof(Index)), 1), n);
+    const std::string plcp_path = lcp_path + ".plcp";
+
+    // plcp[i - lo] = Phi and then PLCP of position i in [lo, hi); PLCP
+    // drops by at most one per position, so h carries over chunks
+    std::vector<Index> plcp;
+    {
+        std::unique_ptr<FileWriter<Index>> plcp_out;
+        if (chunk < n) plcp_out.reset(new FileWriter<Index>(plcp_path));
+        Index h = 0;
+        for (Index lo = 0; lo < n; lo += chunk) {
+            const Index hi = std::min<Index>(n - lo, chunk) + lo;
+            plcp.assign(hi - lo, 0);
+            for (Index i = 0; i < n; i++) {
+                if (sa[i] < 0 || sa[i] >= n)
+                    throw std::runtime_error("suffix array out of range: " +
+                                             sa_path);
+                if (lo <= sa[i] && sa[i] < hi)
+                    plcp[sa[i] - lo] = i == 0 ? -1 : sa[i - 1];
+            }
+            for (Index i = lo; i < hi; i++) {
+                Index j = plcp[i - lo];
+                if (j < 0) {
+                    plcp[i - lo] = h = 0;
+                    continue;
+                }
+                while (i + h < n && j + h < n && s[i + h] == s[j + h]) ++h;
+                plcp[i - lo] = h;
+                if (h > 0) --h;
+            }
+            if (plcp_out)
+                for (Index x : plcp) plcp_out->push(x);
+        }
+        if (plcp_out) plcp_out->close();
+    }
+
+    if (chunk == n) {
+        for (Index i = 1; i < n; i++) out.push(plcp[sa[i]]);
+        out.close();
+        return;
+    }
+    std::vector<Index>().swap(plcp);
+    {
+        MappedFile<Index> p(plcp_path);
+        std::vector<std::pair<Index, Index>> at;
+        std::vector<Index> buf;
+        for (Index lo = 1; lo < n; lo += chunk) {
+            const Index hi = std::min<Index>(n - lo, chunk) + lo;
+            at.clear();
+            for (Index i = lo; i < hi; i++) at.emplace_back(sa[i], i - lo);
+            std::sort(at.begin(), at.end());
+            buf.resize(hi - lo);
+            for (auto [x, k] : at) buf[k] = p[x];
+            for (Index x : buf) out.push(x);
+        }
+    }
+    out.close();
+    std::remove(plcp_path.c_str());
+}
+
+// Suffix array and LCP array of the bytes in text_path, written to
+// sa_path and lcp_path as raw arrays of Index (n and n - 1 entries, the
+// layout of suffix_array / lcp_array) that can be opened as
+// MappedFile<Index>. Throws std::runtime_error if n does not fit in
+// Index or a file cannot be written.
+// Blockwise suffix sorting: the text, memory mapped, is cut into blocks
+// of about memory_limit / 32 bytes, processed from the right. The
+// suffixes of a block are sorted in memory by SA-IS, the suffixes to the
+// right of the block are counted into the gaps between them by
+// LF-mapping over the BWT of the block, and both are merged into the
+// suffix array file in one sequential pass. A block costs O(n log sigma)
+// time and O(n) sequential I/O. The LCP array is then computed from the
+// finished suffix array by build_lcp_file under the same memory_limit.
+// sa_path + ".tmp", ".gt0", ".gt1" and lcp_path + ".plcp" are used as
+// scratch files.
+template <class Index = int>
+void build_external_suffix_array(const std::string &text_path,
+                                 const std::string &sa_path,
+                                 const std::string &lcp_path,
+                                 size_t memory_limit = size_t(1) << 30) {
+    {
+        MappedFile<uint8_t> text(text_path);
+        if (text.size() > size_t(std::numeric_limits<Index>::max()))
+            throw std::runtime_error("text too long for Index: " + text_path);
+        const size_t block =
+            std::min<size_t>(std::max<size_t>(memory_limit / 32, 1),
+                             std::numeric_limits<int>::max() - 1);
+        external_suffix_array_internal::sort_blockwise<Index>(
+            text.data(), text.size(), block, sa_path);
+    }
+    build_lcp_file<Index>(text_path, sa_path, lcp_path, memory_limit);
+}
+
+}  // namespace rklib
+
+#endif  // RK_EXTERNAL_SUFFIX_ARRAY_HPP
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef RK_FM_INDEX_HPP
+#define RK_FM_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <rklib/data_structure/bit_vector.hpp>
+#include <rklib/data_structure/wavelet_matrix.hpp>
+#include <rklib/string/suffix_array.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rklib {
+
+// Compressed FM-index over bytes. The BWT of s$ is kept in a wavelet
+// matrix of 8 levels (rank and access in 8 bit-vector ranks) and the
+// suffix array only at text positions divisible by sample_rate; locate
+// walks LF from a row until it meets a sample, at most sample_rate - 1
+// steps. The sentinel is stored as byte 0 at row primary and corrected
+// for in rank.
+struct FMIndex {
+   public:
+    FMIndex() {}
+    FMIndex(const std::string &s, int sample_rate = 32) : n(s.size() + 1) {
+        // row 0 is the sentinel suffix, row i > 0 is sa[i - 1]; sa is
+        // released before the rank structures are built
+        std::vector<uint8_t> bwt(n, 0);
+        sampled = BitVector<int>(n);
+        {
+            auto sa = suffix_array(s);
+            for (int i = 0; i < n; i++) {
+                int p = i == 0 ? n - 1 : sa[i - 1];
+                if (p == 0)
+                    primary = i;
+                else
+                    bwt[i] = s[p - 1];
+                if (p % sample_rate == 0) {
+                    sampled.set(i);
+                    samples.push_back(p);
+                }
+            }
+        }
+        sampled.build();
+        wm = WaveletMatrix<uint8_t, 8>(std::move(bwt));
+
+        // the sentinel row comes first
+        cnt_smaller.assign(257, 0);
+        cnt_smaller[0] = 1;
+        for (char c : s) ++cnt_smaller[uint8_t(c) + 1];
+        std::partial_sum(cnt_smaller.begin(), cnt_smaller.end(),
+                         cnt_smaller.begin());
+    }
+
+    // range of rows prefixed by p
+    std::pair<int, int> fm_index(const std::string &p) {
+        int l = 0, r = n;
+        for (int i = (int)p.size() - 1; i >= 0 && l < r; --i) {
+            int c = uint8_t(p[i]);
+            l = cnt_smaller[c] + rank(c, l);
+            r = cnt_smaller[c] + rank(c, r);
+        }
+        return {l, r};
+    }
+
+    int count(const std::string &p) {
+        auto [l, r] = fm_index(p);
+        return r - l;
+    }
+
+    bool contains(const std::string &p) { return count(p) > 0; }
+
+    std::vector<int> find_all(const std::string &p) {
+        auto [l, r] = fm_index(p);
+        std::vector<int> res;
+        for (int i = l; i < r; i++) res.push_back(locate(i));
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    // text position of row i
+    int locate(int i) {
+        int steps = 0;
+        while (!sampled.get(i)) {
+            int c = wm.access(i);
+            i = cnt_smaller[c] + rank(c, i);
+            ++steps;
+        }
+        return samples[sampled.rank(i, 1)] + steps;
+    }
+
+    std::size_t memory_bytes() const {
+        return wm.memory_bytes() + sampled.memory_bytes() +
+               samples.size() * sizeof(int) +
+               cnt_smaller.size() * sizeof(int);
+    }
+
+    double bits_per_symbol() const { return 8.0 * memory_bytes() / n; }
+
+   private:
+    int n = 0, primary = 0;
+    WaveletMatrix<uint8_t, 8> wm;
+    BitVector<int> sampled;
+    std::vector<int> samples, cnt_smaller;
+
+    int rank(int c, int i) {
+        int res = wm.rank(c, i);
+        if (c == 0 && primary < i) --res;
+        return res;
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_FM_INDEX_HPP
\ No newline at end of file
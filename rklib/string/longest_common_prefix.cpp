@@ -13,4 +13,27 @@ vector<int> lcp_array(string &s, vector<int> &sa) {
         lcp[rnk[i] - 1] = h;
     }
     return lcp;
+}
+
+// Phi algorithm: PLCP is computed in text order, so the text is scanned
+// sequentially and the only random access is the final permutation
+vector<int> lcp_array_phi(string &s, vector<int> &sa) {
+    int n = s.size();
+    if (n == 0) return {};
+    vector<int> plcp(n);
+    plcp[sa[0]] = -1;
+    for (int i = 1; i < n; ++i) plcp[sa[i]] = sa[i - 1];
+    for (int i = 0, h = 0; i < n; ++i) {
+        int j = plcp[i];
+        if (j < 0) {
+            plcp[i] = h = 0;
+            continue;
+        }
+        while (i + h < n && j + h < n && s[i + h] == s[j + h]) ++h;
+        plcp[i] = h;
+        if (h > 0) --h;
+    }
+    vector<int> lcp(n - 1);
+    for (int i = 0; i + 1 < n; ++i) lcp[i] = plcp[sa[i + 1]];
+    return lcp;
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+#ifndef RK_SUFFIX_ARRAY_HPP
+#define RK_SUFFIX_ARRAY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <rklib/utility/coordinate_compression.hpp>
+#include <string>
+#include <vector>
+
+namespace rklib {
+
+// SA-IS. Index is the index type (long long for texts over 2^31 - 1).
+// The buffers of every recursion level are kept in the object and
+// reused by later calls to build.
+template <class Index = int>
+struct SuffixArrayBuilder {
+   public:
+    SuffixArrayBuilder() : levels(8 * sizeof(Index) + 1) {}
+
+    // every s[i] must be in [0, upper]
+    template <class T>
+    std::vector<Index> build(const std::vector<T> &s, Index upper) {
+        std::vector<Index> sa(s.size());
+        sa_is(s.data(), Index(s.size()), upper, sa.data(), 0);
+        return sa;
+    }
+
+    // bytes are compared as unsigned char
+    std::vector<Index> build(const std::string &s) {
+        std::vector<Index> sa(s.size());
+        sa_is(reinterpret_cast<const uint8_t *>(s.data()), Index(s.size()),
+              255, sa.data(), 0);
+        return sa;
+    }
+
+   private:
+    struct Level {
+        std::vector<uint8_t> ls;
+        std::vector<Index> sum_l, sum_s, buf, lms_map, lms, sorted_lms, rec_s,
+            rec_sa;
+    };
+    std::vector<Level> levels;
+
+    template <class T>
+    void sa_is(const T *s, Index n, Index upper, Index *sa, int d) {
+        if (n == 0) return;
+        if (n == 1) {
+            sa[0] = 0;
+            return;
+        }
+        if (n == 2) {
+            sa[0] = (s[0] < s[1] ? 0 : 1);
+            sa[1] = 1 - sa[0];
+            return;
+        }
+
+        auto &lv = levels[d];
+        auto &ls = lv.ls;
+        ls.assign(n, 0);
+        for (Index i = n - 2; i >= 0; i--)
+            ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+
+        auto &sum_l = lv.sum_l, &sum_s = lv.sum_s, &buf = lv.buf;
+        sum_l.assign(upper + 1, 0);
+        sum_s.assign(upper + 1, 0);
+        buf.resize(upper + 1);
+        for (Index i = 0; i < n; i++) {
+            if (!ls[i])
+                sum_s[s[i]]++;
+            else
+                sum_l[s[i] + 1]++;
+        }
+        for (Index i = 0; i <= upper; i++) {
+            sum_s[i] += sum_l[i];
+            if (i < upper) sum_l[i + 1] += sum_s[i];
+        }
+
+        auto induce = [&](const std::vector<Index> &lms) {
+            std::fill(sa, sa + n, -1);
+            std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+            for (auto p : lms) {
+                if (p == n) continue;
+                sa[buf[s[p]]++] = p;
+            }
+            std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+            sa[buf[s[n - 1]]++] = n - 1;
+            for (Index i = 0; i < n; i++) {
+                Index v = sa[i];
+                if (v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+            }
+            std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+            for (Index i = n - 1; i >= 0; i--) {
+                Index v = sa[i];
+                if (v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+            }
+        };
+
+        auto &lms_map = lv.lms_map, &lms = lv.lms;
+        lms_map.assign(n + 1, -1);
+        lms.clear();
+        Index m = 0;
+        for (Index i = 1; i < n; i++) {
+            if (!ls[i - 1] && ls[i]) {
+                lms_map[i] = m++;
+                lms.push_back(i);
+            }
+        }
+        induce(lms);
+        if (m == 0) return;
+
+        auto &sorted_lms = lv.sorted_lms, &rec_s = lv.rec_s;
+        sorted_lms.clear();
+        for (Index i = 0; i < n; i++)
+            if (lms_map[sa[i]] != -1) sorted_lms.push_back(sa[i]);
+        rec_s.resize(m);
+        Index rec_upper = 0;
+        rec_s[lms_map[sorted_lms[0]]] = 0;
+        for (Index i = 1; i < m; i++) {
+            Index l = sorted_lms[i - 1], r = sorted_lms[i];
+            Index end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            Index end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+            bool same = true;
+            if (end_l - l != end_r - r) {
+                same = false;
+            } else {
+                while (l < end_l && s[l] == s[r]) l++, r++;
+                if (l == n || s[l] != s[r]) same = false;
+            }
+            if (!same) rec_upper++;
+            rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+        }
+
+        auto &rec_sa = lv.rec_sa;
+        rec_sa.resize(m);
+        sa_is(rec_s.data(), m, rec_upper, rec_sa.data(), d + 1);
+        for (Index i = 0; i < m; i++) sorted_lms[i] = lms[rec_sa[i]];
+        induce(sorted_lms);
+    }
+};
+
+namespace suffix_array_internal {
+
+// Prefix doubling in the style of Larsson-Sadakane: after every round
+// only the groups of suffixes still tied on their first k characters
+// are sorted again, by the rank of the suffix k positions later. The
+// rank of a suffix is the head of its group in sa. Small groups are
+// spread over the threads; a group larger than its share is sorted
+// with the sample sort of coordinate_compression.hpp.
+template <class Index, class T>
+std::vector<Index> prefix_doubling(const T *s, Index n, Index upper,
+                                   int num_threads) {
+    using coord_comp_internal::run_parallel;
+    const int p = num_threads;
+    std::vector<Index> sa(n), rnk(n), tmp(n);
+    std::vector<std::pair<Index, Index>> groups;  // [l, r) of sa
+
+    std::vector<Index> cnt(upper + 2, 0);
+    for (Index i = 0; i < n; i++) ++cnt[Index(s[i]) + 1];
+    std::partial_sum(cnt.begin(), cnt.end(), cnt.begin());
+    for (Index c = 0; c <= upper; c++)
+        if (cnt[c + 1] - cnt[c] >= 2) groups.emplace_back(cnt[c], cnt[c + 1]);
+    for (Index i = 0; i < n; i++) rnk[i] = cnt[s[i]];
+    for (Index i = 0; i < n; i++) sa[cnt[s[i]]++] = i;
+
+    std::vector<std::vector<std::pair<Index, Index>>> next(p);
+    auto part = [&](Index l, Index r, int t) {
+        return Index(l + (long long)(r - l) * t / p);
+    };
+    for (Index k = 1; !groups.empty(); k <<= 1) {
+        auto key = [&](Index i) { return i + k < n ? rnk[i + k] : Index(-1); };
+        const int g = groups.size();
+        std::vector<long long> pre(g + 1, 0);
+        for (int j = 0; j < g; j++)
+            pre[j + 1] = pre[j] + groups[j].second - groups[j].first;
+        const long long total = pre[g], big = std::max(total / p, 1LL << 12);
+        // groups [from[t], from[t + 1]) go to thread t
+        std::vector<int> from(p + 1, g);
+        for (int j = g - 1; j >= 0; j--) from[pre[j] * p / total] = j;
+        for (int t = p - 1; t >= 0; t--)
+            from[t] = std::min(from[t], from[t + 1]);
+
+        for (auto [l, r] : groups) {
+            if (p == 1 || r - l < big) continue;
+            std::vector<std::array<Index, 2>> v(r - l);
+            run_parallel(p, [&](int t) {
+                for (Index j = part(l, r, t); j < part(l, r, t + 1); j++)
+                    v[j - l] = {key(sa[j]), sa[j]};
+            });
+            coord_comp_internal::parallel_sort_unique(v, p);
+            run_parallel(p, [&](int t) {
+                for (Index j = part(l, r, t); j < part(l, r, t + 1); j++)
+                    tmp[j] = v[j - l][0], sa[j] = v[j - l][1];
+            });
+        }
+        run_parallel(p, [&](int t) {
+            for (int j = from[t]; j < from[t + 1]; j++) {
+                auto [l, r] = groups[j];
+                if (p > 1 && r - l >= big) continue;
+                std::sort(sa.begin() + l, sa.begin() + r,
+                          [&](Index a, Index b) { return key(a) < key(b); });
+                for (Index i = l; i < r; i++) tmp[i] = key(sa[i]);
+            }
+        });
+        // every key is read, so the ranks can be overwritten
+        run_parallel(p, [&](int t) {
+            next[t].clear();
+            for (int j = from[t]; j < from[t + 1]; j++) {
+                auto [l, r] = groups[j];
+                for (Index i = l, h = l; i < r; i++) {
+                    if (tmp[i] != tmp[h]) {
+                        if (i - h >= 2) next[t].emplace_back(h, i);
+                        h = i;
+                    }
+                    rnk[sa[i]] = h;
+                    if (i + 1 == r && r - h >= 2) next[t].emplace_back(h, r);
+                }
+            }
+        });
+        groups.clear();
+        for (auto &v : next) groups.insert(groups.end(), v.begin(), v.end());
+    }
+    return sa;
+}
+
+constexpr size_t parallel_threshold = 1 << 16;
+
+}  // namespace suffix_array_internal
+
+inline std::vector<int> suffix_array(const std::string &s) {
+    return SuffixArrayBuilder<int>().build(s);
+}
+
+template <class T>
+std::vector<int> suffix_array(const std::vector<T> &s, int upper) {
+    return SuffixArrayBuilder<int>().build(s, upper);
+}
+
+// Suffix array by prefix doubling on num_threads threads. Falls back to
+// SA-IS for one thread or short inputs.
+template <class Index = int>
+std::vector<Index> parallel_suffix_array(const std::string &s,
+                                         int num_threads) {
+    if (num_threads <= 1 ||
+        s.size() < suffix_array_internal::parallel_threshold)
+        return SuffixArrayBuilder<Index>().build(s);
+    return suffix_array_internal::prefix_doubling(
+        reinterpret_cast<const uint8_t *>(s.data()), Index(s.size()),
+        Index(255), num_threads);
+}
+
+// every s[i] must be in [0, upper]
+template <class Index = int, class T>
+std::vector<Index> parallel_suffix_array(const std::vector<T> &s, Index upper,
+                                         int num_threads) {
+    if (num_threads <= 1 ||
+        s.size() < suffix_array_internal::parallel_threshold)
+        return SuffixArrayBuilder<Index>().build(s, upper);
+    return suffix_array_internal::prefix_doubling(s.data(), Index(s.size()),
+                                                  upper, num_threads);
+}
+
+}  // namespace rklib
+
+#endif  // RK_SUFFIX_ARRAY_HPP
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef RK_ALGEBRA_HPP
+#define RK_ALGEBRA_HPP
+
+namespace rklib {
+
+// Containers taking a monoid M expect
+//   using S = ...;  S op(S, S);  S e();
+// and containers taking an act A additionally expect
+//   using F = ...;  S mapping(F, S);  F composition(F, F);  F id();
+// The members may be static or not. The container keeps a copy of M / A,
+// so runtime state (e.g. a modulus) can live in the struct, and calls
+// through it inline unlike function pointers.
+
+// adapter for the function pointer template parameters
+template <class S_, S_ (*op_)(S_, S_), S_ (*e_)()>
+struct FunctionMonoid {
+    using S = S_;
+    static S op(S a, S b) { return op_(a, b); }
+    static S e() { return e_(); }
+};
+
+template <class S_, S_ (*op_)(S_, S_), S_ (*e_)(), class F_,
+          S_ (*mapping_)(F_, S_), F_ (*composition_)(F_, F_), F_ (*id_)()>
+struct FunctionAct : FunctionMonoid<S_, op_, e_> {
+    using S = S_;
+    using F = F_;
+    static S mapping(F f, S x) { return mapping_(f, x); }
+    static F composition(F f, F g) { return composition_(f, g); }
+    static F id() { return id_(); }
+};
+
+}  // namespace rklib
+
+#endif  // RK_ALGEBRA_HPP
\ No newline at end of file
@@ -1,23 +1,196 @@
 #ifndef RK_COORD_COMP_HPP
 #define RK_COORD_COMP_HPP
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 namespace rklib {
 
+namespace coord_comp_internal {
+
+// order-preserving map of an integer to its unsigned counterpart
+template <class T>
+std::make_unsigned_t<T> to_unsigned(T x) {
+    using U = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>)
+        return U(x) ^ (U(1) << (sizeof(T) * 8 - 1));
+    else
+        return U(x);
+}
+
+// LSD radix sort with 8-bit digits; digits shared by all keys are skipped
+template <class T, class Key>
+void radix_sort(std::vector<T> &a, Key key) {
+    constexpr int bits = sizeof(decltype(key(a[0]))) * 8;
+    std::vector<T> buf(a.size());
+    std::vector<size_t> cnt(257);
+    for (int s = 0; s < bits; s += 8) {
+        std::fill(cnt.begin(), cnt.end(), 0);
+        for (auto &x : a) ++cnt[(key(x) >> s & 255) + 1];
+        if (*std::max_element(cnt.begin(), cnt.end()) == a.size()) continue;
+        std::partial_sum(cnt.begin(), cnt.end(), cnt.begin());
+        for (auto &x : a) buf[cnt[key(x) >> s & 255]++] = x;
+        a.swap(buf);
+    }
+}
+
+template <class F>
+void run_parallel(int num_threads, F f) {
+    std::vector<std::thread> ths;
+    for (int t = 0; t < num_threads; t++) ths.emplace_back(f, t);
+    for (auto &th : ths) th.join();
+}
+
+// sort + unique on num_threads threads by sample sort: scatter into
+// buckets split by sampled pivots, sort and unique every bucket on its
+// own thread, then compact the buckets with a prefix sum
+template <class T>
+void parallel_sort_unique(std::vector<T> &a, int num_threads) {
+    constexpr size_t oversample = 32;
+    const int p = num_threads;
+    const size_t n = a.size();
+
+    std::vector<T> smp(p * oversample);
+    for (size_t i = 0; i < smp.size(); i++) smp[i] = a[i * n / smp.size()];
+    std::sort(smp.begin(), smp.end());
+    std::vector<T> piv(p - 1);
+    for (int j = 0; j < p - 1; j++) piv[j] = smp[(j + 1) * oversample];
+    auto bucket = [&](const T &x) {
+        return std::upper_bound(piv.begin(), piv.end(), x) - piv.begin();
+    };
+    auto chunk = [&](int t) { return n * t / p; };
+
+    std::vector<std::vector<size_t>> pos(p, std::vector<size_t>(p, 0));
+    run_parallel(p, [&](int t) {
+        for (size_t i = chunk(t); i < chunk(t + 1); i++) ++pos[t][bucket(a[i])];
+    });
+    std::vector<size_t> start(p + 1, 0);
+    for (int b = 0; b < p; b++) {
+        start[b + 1] = start[b];
+        for (int t = 0; t < p; t++) {
+            size_t c = pos[t][b];
+            pos[t][b] = start[b + 1];
+            start[b + 1] += c;
+        }
+    }
+
+    std::vector<T> buf(n);
+    run_parallel(p, [&](int t) {
+        for (size_t i = chunk(t); i < chunk(t + 1); i++)
+            buf[pos[t][bucket(a[i])]++] = std::move(a[i]);
+    });
+
+    std::vector<size_t> uniq(p + 1, 0);
+    run_parallel(p, [&](int b) {
+        auto l = buf.begin() + start[b], r = buf.begin() + start[b + 1];
+        std::sort(l, r);
+        uniq[b + 1] = std::unique(l, r) - l;
+    });
+    std::partial_sum(uniq.begin(), uniq.end(), uniq.begin());
+
+    run_parallel(p, [&](int b) {
+        auto l = buf.begin() + start[b];
+        std::move(l, l + (uniq[b + 1] - uniq[b]), a.begin() + uniq[b]);
+    });
+    a.resize(uniq[p]);
+}
+
+}  // namespace coord_comp_internal
+
 template <typename T = int>
 struct CoordComp {
     std::vector<T> v;
 
     CoordComp() {}
-    CoordComp(std::vector<T> &a) : v(a) {
-        std::sort(v.begin(), v.end());
-        v.erase(std::unique(v.begin(), v.end()), v.end());
+    CoordComp(std::vector<T> &a) : v(a) { build(); }
+    CoordComp(std::vector<T> &&a) : v(std::move(a)) { build(); }
+    CoordComp(std::vector<T> &a, int num_threads)
+        : CoordComp(std::vector<T>(a), num_threads) {}
+    CoordComp(std::vector<T> &&a, int num_threads) : v(std::move(a)) {
+        if (num_threads <= 1 || v.size() < parallel_threshold) {
+            build();
+        } else {
+            coord_comp_internal::parallel_sort_unique(v, num_threads);
+        }
     }
 
     int size() { return v.size(); }
 
-    int get_idx(T x) { return lower_bound(v.begin(), v.end(), x) - v.begin(); }
+    int get_idx(T x) {
+        if (!eytz.empty()) return eytzinger_lower_bound(x);
+        return lower_bound(v.begin(), v.end(), x) - v.begin();
+    }
+
+    // get_idx for many queries at once: sort the queries, then merge
+    std::vector<int> get_idx_many(const std::vector<T> &xs) {
+        std::vector<std::pair<T, int>> qs(xs.size());
+        for (size_t i = 0; i < xs.size(); i++) qs[i] = {xs[i], i};
+        if constexpr (std::is_integral_v<T>) {
+            coord_comp_internal::radix_sort(
+                qs, [](const std::pair<T, int> &q) {
+                    return coord_comp_internal::to_unsigned(q.first);
+                });
+        } else {
+            std::sort(qs.begin(), qs.end());
+        }
+        std::vector<int> res(xs.size());
+        size_t j = 0;
+        for (auto &[x, i] : qs) {
+            while (j < v.size() && v[j] < x) ++j;
+            res[i] = j;
+        }
+        return res;
+    }
+
+    // Lay out v in BFS (Eytzinger) order so that get_idx walks a
+    // cache-friendly implicit tree. Call again after modifying v.
+    void build_eytzinger() {
+        eytz.assign(v.size() + 1, T());
+        eytz_idx.assign(v.size() + 1, 0);
+        int i = 0;
+        eytzinger_fill(1, i);
+    }
 
     T &operator[](int i) { return v[i]; }
+
+   private:
+    static constexpr size_t radix_threshold = 1 << 10;
+    static constexpr size_t parallel_threshold = 1 << 16;
+    std::vector<T> eytz;
+    std::vector<int> eytz_idx;
+
+    void build() {
+        if constexpr (std::is_integral_v<T>) {
+            if (v.size() >= radix_threshold) {
+                coord_comp_internal::radix_sort(v, [](T x) {
+                    return coord_comp_internal::to_unsigned(x);
+                });
+            } else {
+                std::sort(v.begin(), v.end());
+            }
+        } else {
+            std::sort(v.begin(), v.end());
+        }
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+    }
+
+    void eytzinger_fill(size_t k, int &i) {
+        if (k > v.size()) return;
+        eytzinger_fill(2 * k, i);
+        eytz[k] = v[i];
+        eytz_idx[k] = i++;
+        eytzinger_fill(2 * k + 1, i);
+    }
+
+    int eytzinger_lower_bound(T x) {
+        size_t k = 1, n = v.size();
+        while (k <= n) k = 2 * k + (eytz[k] < x);
+        k >>= __builtin_ffsll(~k);
+        return k == 0 ? n : eytz_idx[k];
+    }
 };
 
 }  // namespace rklib
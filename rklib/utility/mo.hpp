@@ -0,0 +1,139 @@
+#ifndef RK_MO_HPP
+#define RK_MO_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace rklib {
+
+// Offline queries on [l, r) that can be answered by moving the ends of
+// a window one step at a time. Callbacks are template functors:
+//   add_left(i) / remove_left(i): i enters / leaves at the left end
+//   add_right(i) / remove_right(i): i enters / leaves at the right end
+//   out(q): the window equals query q
+struct Mo {
+   public:
+    Mo(int n) : n(n) {}
+
+    void add_query(int l, int r) {
+        assert(0 <= l && l <= r && r <= n);
+        ls.push_back(l);
+        rs.push_back(r);
+    }
+
+    // queries sorted along a Hilbert curve over (l, r)
+    template <class AL, class AR, class RL, class RR, class O>
+    void run(AL add_left, AR add_right, RL remove_left, RR remove_right,
+             O out) {
+        int q = ls.size();
+        int lg = 1;
+        while ((1 << lg) < n + 1) ++lg;
+        std::vector<long long> d(q);
+        for (int i = 0; i < q; i++) d[i] = hilbert_order(ls[i], rs[i], lg);
+        std::vector<int> ord(q);
+        std::iota(ord.begin(), ord.end(), 0);
+        std::sort(ord.begin(), ord.end(),
+                  [&](int i, int j) { return d[i] < d[j]; });
+        sweep(ord, add_left, add_right, remove_left, remove_right, out);
+    }
+
+    // queries sorted by block of l, then r (alternating)
+    template <class AL, class AR, class RL, class RR, class O>
+    void run_block(AL add_left, AR add_right, RL remove_left, RR remove_right,
+                   O out) {
+        int q = ls.size();
+        int bs = block_size();
+        std::vector<int> ord(q);
+        std::iota(ord.begin(), ord.end(), 0);
+        std::sort(ord.begin(), ord.end(), [&](int i, int j) {
+            int bi = ls[i] / bs, bj = ls[j] / bs;
+            if (bi != bj) return bi < bj;
+            return (bi & 1) ? rs[i] > rs[j] : rs[i] < rs[j];
+        });
+        sweep(ord, add_left, add_right, remove_left, remove_right, out);
+    }
+
+    // Mo without removal: the window only grows from a block border and
+    // is restored with rollback().
+    //   reset(): clear the state (called at every block)
+    //   snapshot() / rollback(): save / restore the state
+    template <class AL, class AR, class RS, class SN, class RB, class O>
+    void run_rollback(AL add_left, AR add_right, RS reset, SN snapshot,
+                      RB rollback, O out) {
+        int q = ls.size();
+        int bs = block_size();
+        std::vector<int> ord(q);
+        std::iota(ord.begin(), ord.end(), 0);
+        std::sort(ord.begin(), ord.end(), [&](int i, int j) {
+            int bi = ls[i] / bs, bj = ls[j] / bs;
+            if (bi != bj) return bi < bj;
+            return rs[i] < rs[j];
+        });
+        reset();
+        for (int k = 0; k < q;) {
+            int b = ls[ord[k]] / bs, border = (b + 1) * bs;
+            int r = border;
+            for (; k < q && ls[ord[k]] / bs == b; k++) {
+                int i = ord[k];
+                if (rs[i] <= border) {
+                    snapshot();
+                    for (int j = ls[i]; j < rs[i]; j++) add_right(j);
+                    out(i);
+                    rollback();
+                    continue;
+                }
+                while (r < rs[i]) add_right(r++);
+                snapshot();
+                for (int j = border - 1; j >= ls[i]; j--) add_left(j);
+                out(i);
+                rollback();
+            }
+            reset();
+        }
+    }
+
+   private:
+    int n;
+    std::vector<int> ls, rs;
+
+    int block_size() {
+        int q = std::max<int>(ls.size(), 1);
+        return std::max<int>(1, n / std::sqrt(q));
+    }
+
+    static long long hilbert_order(int x, int y, int lg) {
+        long long d = 0;
+        for (int s = 1 << (lg - 1); s > 0; s >>= 1) {
+            int rx = (x & s) > 0, ry = (y & s) > 0;
+            d += (long long)s * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = (1 << lg) - 1 - x;
+                    y = (1 << lg) - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return d;
+    }
+
+    template <class AL, class AR, class RL, class RR, class O>
+    void sweep(const std::vector<int> &ord, AL &add_left, AR &add_right,
+               RL &remove_left, RR &remove_right, O &out) {
+        int l = 0, r = 0;
+        for (int i : ord) {
+            while (l > ls[i]) add_left(--l);
+            while (r < rs[i]) add_right(r++);
+            while (l < ls[i]) remove_left(l++);
+            while (r > rs[i]) remove_right(--r);
+            out(i);
+        }
+    }
+};
+
+}  // namespace rklib
+
+#endif  // RK_MO_HPP
\ No newline at end of file